@@ -22,6 +22,8 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/config-manager.h"
+#include "common/memorypool.h"
 #include "common/util.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -31,6 +33,10 @@
 #include "audio/audiostream.h"
 #include "audio/timestamp.h"
 
+#if defined(__SSE2__) && !defined(OUTPUT_UNSIGNED_AUDIO)
+#define USE_SSE2_MIXING
+#include <emmintrin.h>
+#endif
 
 namespace Audio {
 
@@ -47,6 +53,11 @@ public:
 	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent);
 	~Channel();
 
+	// Channels are usually created by the engine and destroyed by the
+	// audio thread, thus they are allocated from the shared memory pool.
+	void *operator new(size_t size) { return SharedMemPool.allocate(size); }
+	void operator delete(void *ptr, size_t size) { SharedMemPool.free(ptr, size); }
+
 	/**
 	 * Mixes the channel's samples into the given buffer.
 	 *
@@ -58,10 +69,20 @@ public:
 	 */
 	int mix(int16 *data, uint len);
 
+	/**
+	 * Mixes the channel's samples into the given 32-bit buffer, without
+	 * clamping them.
+	 *
+	 * @param data buffer where to mix the data
+	 * @param len  number of sample *pairs*
+	 * @return number of sample pairs processed (which can still be silence!)
+	 */
+	int mix(int32 *data, uint len);
+
 	/**
 	 * Queries whether the channel is still playing or not.
 	 */
-	bool isFinished() const { return _stream->endOfStream(); }
+	bool isFinished() const { return _stream->endOfStream() && !_converter->hasPendingOutput(); }
 
 	/**
 	 * Queries whether the channel is a permanent channel.
@@ -157,6 +178,9 @@ private:
 	void updateChannelVolumes();
 	st_volume_t _volL, _volR;
 
+	/** Mixes into data16, or into data32 if it is not null. */
+	int mix(int16 *data16, int32 *data32, uint len);
+
 	Mixer *_mixer;
 
 	uint32 _samplesConsumed;
@@ -175,17 +199,28 @@ private:
 
 // TODO: parameter "system" is unused
 MixerImpl::MixerImpl(OSystem *system, uint sampleRate)
-	: _mutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _mutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings(),
+	  _useMixBus(false), _mixBus(0), _mixBusSize(0) {
 
 	assert(sampleRate > 0);
 
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		_channels[i] = 0;
+
+	// Make sure the shared memory pool is created before the audio thread
+	// might use it.
+	SharedMemPool;
+
+#ifndef OUTPUT_UNSIGNED_AUDIO
+	_useMixBus = ConfMan.hasKey("mixer_32bit_bus") && ConfMan.getBool("mixer_32bit_bus");
+#endif
 }
 
 MixerImpl::~MixerImpl() {
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
+
+	free(_mixBus);
 }
 
 void MixerImpl::setReady(bool ready) {
@@ -279,8 +314,20 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	// Since the mixer callback has been called, the mixer must be ready...
 	_mixerReady = true;
 
+	if (_useMixBus && len > _mixBusSize) {
+		free(_mixBus);
+		_mixBus = (int32 *)malloc(2 * len * sizeof(int32));
+		_mixBusSize = len;
+
+		if (!_mixBus)
+			error("[MixerImpl::mixCallback] Cannot allocate memory for mix bus");
+	}
+
 	//  zero the buf
-	memset(buf, 0, 2 * len * sizeof(int16));
+	if (_useMixBus)
+		memset(_mixBus, 0, 2 * len * sizeof(int32));
+	else
+		memset(buf, 0, 2 * len * sizeof(int16));
 
 	// mix all channels
 	int res = 0, tmp;
@@ -290,16 +337,37 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 				delete _channels[i];
 				_channels[i] = 0;
 			} else if (!_channels[i]->isPaused()) {
-				tmp = _channels[i]->mix(buf, len);
+				if (_useMixBus)
+					tmp = _channels[i]->mix(_mixBus, len);
+				else
+					tmp = _channels[i]->mix(buf, len);
 
 				if (tmp > res)
 					res = tmp;
 			}
 		}
 
+	if (_useMixBus)
+		clampMixBus(buf, _mixBus, 2 * len);
+
 	return res;
 }
 
+void MixerImpl::clampMixBus(int16 *dst, const int32 *src, uint samples) {
+#ifdef USE_SSE2_MIXING
+	for (; samples >= 8; samples -= 8) {
+		const __m128i lo = _mm_loadu_si128((const __m128i *)src);
+		const __m128i hi = _mm_loadu_si128((const __m128i *)(src + 4));
+		_mm_storeu_si128((__m128i *)dst, _mm_packs_epi32(lo, hi));
+		src += 8;
+		dst += 8;
+	}
+#endif
+
+	for (; samples > 0; --samples)
+		*dst++ = (int16)CLIP<int32>(*src++, -32768, 32767);
+}
+
 void MixerImpl::stopAll() {
 	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
@@ -608,17 +676,29 @@ Timestamp Channel::getElapsedTime() {
 }
 
 int Channel::mix(int16 *data, uint len) {
+	return mix(data, 0, len);
+}
+
+int Channel::mix(int32 *data, uint len) {
+	return mix(0, data, len);
+}
+
+int Channel::mix(int16 *data16, int32 *data32, uint len) {
 	assert(_stream);
+	assert(_converter);
 
 	int res = 0;
-	if (_stream->endOfData()) {
-		// TODO: call drain method
-	} else {
-		assert(_converter);
+	// The converter may still hold output for the last samples of the
+	// stream, which it produces when flow() is called after the end of the
+	// stream.
+	if (!_stream->endOfData() || (_stream->endOfStream() && _converter->hasPendingOutput())) {
 		_samplesConsumed = _samplesDecoded;
 		_mixerTimeStamp = g_system->getMillis(true);
 		_pauseTime = 0;
-		res = _converter->flow(*_stream, data, len, _volL, _volR);
+		if (data32)
+			res = _converter->flow32(*_stream, data32, len, _volL, _volR);
+		else
+			res = _converter->flow(*_stream, data16, len, _volL, _volR);
 		_samplesDecoded += res;
 	}
 
@@ -70,6 +70,15 @@ private:
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	/**
+	 * Whether channels are mixed into a 32-bit intermediate buffer first,
+	 * which is only clamped to 16 bits once all channels are mixed. This
+	 * avoids clipping that depends on the order in which channels are mixed.
+	 */
+	bool _useMixBus;
+	int32 *_mixBus;
+	uint _mixBusSize;
+
 
 public:
 
@@ -121,6 +130,9 @@ public:
 protected:
 	void insertChannel(SoundHandle *handle, Channel *chan);
 
+	/** Clamp the mixed samples of the mix bus into the 16-bit output buffer. */
+	static void clampMixBus(int16 *dst, const int32 *src, uint samples);
+
 public:
 	/**
 	 * The mixer callback function, to be called at regular intervals by
@@ -24,6 +24,7 @@
 #define AUDIO_RATE_H
 
 #include "common/scummsys.h"
+#include "common/util.h"
 
 namespace Audio {
 
@@ -75,7 +76,44 @@ public:
 	 */
 	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) = 0;
 
+	/**
+	 * Same as flow(), but adds the samples to a 32-bit buffer without
+	 * clamping them, so that several channels can be mixed with a single
+	 * clamp at the end.
+	 *
+	 * The default implementation goes through flow() with a temporary
+	 * buffer; converters should override it with a direct version.
+	 * Not available when OUTPUT_UNSIGNED_AUDIO is defined.
+	 *
+	 * @return Number of sample pairs written into the buffer.
+	 */
+	virtual int flow32(AudioStream &input, int32 *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		st_sample_t tmp[512];
+		st_size_t done = 0;
+
+		while (done < osamp) {
+			const st_size_t chunk = MIN<st_size_t>(osamp - done, ARRAYSIZE(tmp) / 2);
+			memset(tmp, 0, sizeof(tmp));
+			const int len = flow(input, tmp, chunk, vol_l, vol_r);
+
+			for (int i = 0; i < len * 2; ++i)
+				obuf[done * 2 + i] += tmp[i];
+			done += len;
+
+			if ((st_size_t)len < chunk)
+				break;
+		}
+		return done;
+	}
+
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) = 0;
+
+	/**
+	 * Whether output for input which has already been read is still held
+	 * back, e.g. in the delay line of a filter. The mixer keeps calling
+	 * flow() at the end of the input stream until this returns false.
+	 */
+	virtual bool hasPendingOutput() const { return false; }
 };
 
 RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false);
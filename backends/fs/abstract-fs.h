@@ -183,6 +183,16 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStream() = 0;
 
+	/**
+	 * Creates a SeekableReadStream instance for read-only game data. Backends
+	 * may map the file into memory instead of reading it, so the file must
+	 * not be truncated or rewritten while the stream exists. Falls back to
+	 * createReadStream() by default.
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual Common::SeekableReadStream *createMappedReadStream() { return createReadStream(); }
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
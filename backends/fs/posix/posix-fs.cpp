@@ -33,6 +33,7 @@
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/fs/stdiostream.h"
 #include "common/algorithm.h"
+#include "common/memstream.h"
 
 #include <sys/param.h>
 #include <sys/stat.h>
@@ -51,6 +52,70 @@
 #include <os2.h>
 #endif
 
+#if defined(POSIX) && !defined(__OS2__)
+#include <unistd.h>
+#include <sys/mman.h>
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#define USE_MEMORY_MAPPED_FILES
+#endif
+#endif
+
+#ifdef USE_MEMORY_MAPPED_FILES
+
+/**
+ * Files at least this large are mapped into memory instead of being read
+ * through stdio. Smaller files are cheap to read anyway, and mapping them
+ * would mostly waste address space and page table entries.
+ */
+#define MEMORY_MAPPED_FILE_MIN_SIZE (1024 * 1024)
+
+/**
+ * A read stream on a file mapped into memory. Reading from it does not go
+ * through the stdio buffer, and getDirectPointer() gives access to the file
+ * content without copying it. The pages are loaded lazily by the kernel, and
+ * may be discarded again under memory pressure since they are backed by the
+ * file.
+ *
+ * Accessing the mapping raises SIGBUS if the file is truncated meanwhile,
+ * so it is only used for read-only game data, see createMappedReadStream().
+ */
+class MemoryMappedReadStream : public Common::MemoryReadStream {
+public:
+	static MemoryMappedReadStream *makeFromPath(const Common::String &path) {
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return 0;
+
+		struct stat st;
+		void *data = MAP_FAILED;
+		if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) &&
+		    st.st_size >= MEMORY_MAPPED_FILE_MIN_SIZE && st.st_size <= 0x7FFFFFFF) {
+			data = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		}
+
+		// The mapping keeps the file referenced on its own
+		close(fd);
+
+		if (data == MAP_FAILED)
+			return 0;
+		return new MemoryMappedReadStream((const byte *)data, st.st_size);
+	}
+
+	~MemoryMappedReadStream() {
+		munmap(const_cast<byte *>(_mapping), _mappingSize);
+	}
+
+private:
+	MemoryMappedReadStream(const byte *data, uint32 size)
+		: Common::MemoryReadStream(data, size, DisposeAfterUse::NO), _mapping(data), _mappingSize(size) {
+	}
+
+	const byte *_mapping;
+	uint32 _mappingSize;
+};
+
+#endif
+
 
 void POSIXFilesystemNode::setFlags() {
 	struct stat st;
@@ -254,6 +319,15 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
 	return StdioStream::makeFromPath(getPath(), false);
 }
 
+Common::SeekableReadStream *POSIXFilesystemNode::createMappedReadStream() {
+#ifdef USE_MEMORY_MAPPED_FILES
+	Common::SeekableReadStream *mapped = MemoryMappedReadStream::makeFromPath(getPath());
+	if (mapped)
+		return mapped;
+#endif
+	return createReadStream();
+}
+
 Common::WriteStream *POSIXFilesystemNode::createWriteStream() {
 	return StdioStream::makeFromPath(getPath(), true);
 }
@@ -282,6 +282,8 @@ void DINGUXSdlGraphicsManager::internUpdateScreen() {
 	updateOSD();
 #endif
 
+	flushDirtyTiles();
+
 	// Force a full redraw if requested
 	if (_forceFull) {
 		_numDirtyRects = 1;
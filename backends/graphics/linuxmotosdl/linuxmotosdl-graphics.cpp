@@ -315,6 +315,8 @@ void LinuxmotoSdlGraphicsManager::internUpdateScreen() {
 	updateOSD();
 #endif
 
+	flushDirtyTiles();
+
 	// Force a full redraw if requested
 	if (_forceFull) {
 		_numDirtyRects = 1;
@@ -279,6 +279,8 @@ void PSP2SdlGraphicsManager::internUpdateScreen() {
 	updateOSD();
 #endif
 
+	flushDirtyTiles();
+
 	// Force a full redraw if requested
 	if (_forceFull) {
 		_numDirtyRects = 1;
@@ -155,6 +155,9 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	_paletteDirtyStart(0), _paletteDirtyEnd(0),
 	_screenIsLocked(false),
 	_graphicsMutex(0),
+	_scalerJobProc(0), _numScalerJobs(0), _nextScalerJob(0), _pendingScalerJobs(0),
+	_scalerMutex(0), _scalerWorkCond(0), _scalerDoneCond(0), _scalerThreadsShouldQuit(false),
+	_dirtyTilesPitch(0), _hasDirtyTiles(false),
 	_displayDisabled(false),
 #ifdef USE_SDL_DEBUG_FOCUSRECT
 	_enableFocusRectDebugCode(false), _enableFocusRect(false), _focusRect(),
@@ -171,6 +174,8 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 
 	_graphicsMutex = g_system->createMutex();
 
+	startScalerThreads();
+
 #ifdef USE_SDL_DEBUG_FOCUSRECT
 	if (ConfMan.hasKey("use_sdl_debug_focusrect"))
 		_enableFocusRectDebugCode = ConfMan.getBool("use_sdl_debug_focusrect");
@@ -213,6 +218,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 }
 
 SurfaceSdlGraphicsManager::~SurfaceSdlGraphicsManager() {
+	stopScalerThreads();
 	unloadGFXMode();
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 	if (_window)
@@ -1095,6 +1101,19 @@ void SurfaceSdlGraphicsManager::updateShader() {
 // hardware-based up-scaling (sharp-bilinear-simple, etc.)
 }
 
+/**
+ * Whether several bands of a frame can be scaled with the given scaler at
+ * the same time. The assembly versions of the HQ scalers keep their state
+ * in global variables, so they must only be used by one thread at a time.
+ */
+static bool isScalerReentrant(ScalerProc *scalerProc) {
+#if defined(USE_NASM) && defined(USE_HQ_SCALERS)
+	if (scalerProc == HQ2x || scalerProc == HQ3x)
+		return false;
+#endif
+	return true;
+}
+
 void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	SDL_Surface *srcSurf, *origSurf;
 	int height, width;
@@ -1160,6 +1179,8 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	updateOSD();
 #endif
 
+	flushDirtyTiles();
+
 	// Force a full redraw if requested
 	if (_forceFull) {
 		_numDirtyRects = 1;
@@ -1191,6 +1212,9 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		srcPitch = srcSurf->pitch;
 		dstPitch = _hwscreen->pitch;
 
+		const uint32 scaleStartTime = SDL_GetTicks();
+		int scaledPixels = 0, numScalerJobs = 0;
+
 		for (r = _dirtyRectList; r != lastRect; ++r) {
 			register int dst_y = r->y + _currentShakePos;
 			register int dst_h = 0;
@@ -1213,8 +1237,12 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 					dst_y = real2Aspect(dst_y);
 
 				assert(scalerProc != NULL);
-				scalerProc((byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
-					(byte *)_hwscreen->pixels + rx1 * 2 + dst_y * dstPitch, dstPitch, r->w, dst_h);
+				addScalerJob((byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
+					(byte *)_hwscreen->pixels + rx1 * 2 + dst_y * dstPitch, dstPitch, r->w, dst_h, scale1,
+					isScalerReentrant(scalerProc));
+				numScalerJobs += _scalerJobs.size();
+				scaledPixels += r->w * dst_h;
+				runScalerJobs(scalerProc);
 			}
 
 			r->x = rx1;
@@ -1227,6 +1255,10 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 				r->h = stretch200To240((uint8 *) _hwscreen->pixels, dstPitch, r->w, r->h, r->x, r->y, orig_dst_y * scale1);
 #endif
 		}
+
+		debug(9, "SurfaceSdlGraphicsManager: Scaled %d of %d pixels in %d rects and %d jobs, took %d ms",
+			scaledPixels, width * height, _numDirtyRects, numScalerJobs, SDL_GetTicks() - scaleStartTime);
+
 		SDL_UnlockSurface(srcSurf);
 		SDL_UnlockSurface(_hwscreen);
 
@@ -1326,6 +1358,131 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	_mouseNeedsRedraw = false;
 }
 
+void SurfaceSdlGraphicsManager::startScalerThreads() {
+	int numThreads = ConfMan.hasKey("scaler_threads") ? ConfMan.getInt("scaler_threads") : 1;
+
+	// The main thread scales as well, so it counts as one of the threads
+	numThreads = CLIP<int>(numThreads, 1, MAX_SCALER_THREADS) - 1;
+	if (numThreads == 0)
+		return;
+
+	_scalerMutex = SDL_CreateMutex();
+	_scalerWorkCond = SDL_CreateCond();
+	_scalerDoneCond = SDL_CreateCond();
+	_scalerThreadsShouldQuit = false;
+
+	for (int i = 0; i < numThreads; ++i) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		SDL_Thread *thread = SDL_CreateThread(scalerThreadEntry, "ScummVM Scaler", this);
+#else
+		SDL_Thread *thread = SDL_CreateThread(scalerThreadEntry, this);
+#endif
+		if (!thread) {
+			warning("Could not create scaler thread: %s", SDL_GetError());
+			break;
+		}
+		_scalerThreads.push_back(thread);
+	}
+}
+
+void SurfaceSdlGraphicsManager::stopScalerThreads() {
+	if (!_scalerMutex)
+		return;
+
+	SDL_LockMutex(_scalerMutex);
+	_scalerThreadsShouldQuit = true;
+	SDL_CondBroadcast(_scalerWorkCond);
+	SDL_UnlockMutex(_scalerMutex);
+
+	for (uint i = 0; i < _scalerThreads.size(); ++i)
+		SDL_WaitThread(_scalerThreads[i], NULL);
+	_scalerThreads.clear();
+
+	SDL_DestroyCond(_scalerWorkCond);
+	SDL_DestroyCond(_scalerDoneCond);
+	SDL_DestroyMutex(_scalerMutex);
+	_scalerWorkCond = _scalerDoneCond = 0;
+	_scalerMutex = 0;
+}
+
+int SDLCALL SurfaceSdlGraphicsManager::scalerThreadEntry(void *arg) {
+	SurfaceSdlGraphicsManager *manager = (SurfaceSdlGraphicsManager *)arg;
+	assert(manager);
+
+	SDL_LockMutex(manager->_scalerMutex);
+	while (!manager->_scalerThreadsShouldQuit) {
+		if (!manager->processScalerJob())
+			SDL_CondWait(manager->_scalerWorkCond, manager->_scalerMutex);
+	}
+	SDL_UnlockMutex(manager->_scalerMutex);
+	return 0;
+}
+
+void SurfaceSdlGraphicsManager::addScalerJob(const uint8 *src, uint32 srcPitch, uint8 *dst, uint32 dstPitch, int width, int height, int scaleFactor, bool splitIntoBands) {
+	int numBands = 1;
+	if (splitIntoBands && !_scalerThreads.empty())
+		numBands = CLIP<int>(height / MIN_SCALER_BAND_HEIGHT, 1, _scalerThreads.size() + 1);
+
+	for (int band = 0; band < numBands; ++band) {
+		// Start the bands on even lines, since some scalers (e.g. DotMatrix)
+		// use patterns which repeat every second source line.
+		const int y1 = (height * band / numBands) & ~1;
+		const int y2 = (band == numBands - 1) ? height : (height * (band + 1) / numBands) & ~1;
+
+		ScalerJob job;
+		job.src = src + y1 * srcPitch;
+		job.srcPitch = srcPitch;
+		job.dst = dst + y1 * scaleFactor * dstPitch;
+		job.dstPitch = dstPitch;
+		job.width = width;
+		job.height = y2 - y1;
+		_scalerJobs.push_back(job);
+	}
+}
+
+void SurfaceSdlGraphicsManager::runScalerJobs(ScalerProc *scalerProc) {
+	if (_scalerThreads.empty()) {
+		for (uint i = 0; i < _scalerJobs.size(); ++i) {
+			const ScalerJob &job = _scalerJobs[i];
+			scalerProc(job.src, job.srcPitch, job.dst, job.dstPitch, job.width, job.height);
+		}
+	} else {
+		SDL_LockMutex(_scalerMutex);
+		_scalerJobProc = scalerProc;
+		_numScalerJobs = _pendingScalerJobs = _scalerJobs.size();
+		_nextScalerJob = 0;
+		SDL_CondBroadcast(_scalerWorkCond);
+
+		// Help scaling, then wait for the bands still being worked on
+		while (processScalerJob())
+			;
+		while (_pendingScalerJobs)
+			SDL_CondWait(_scalerDoneCond, _scalerMutex);
+
+		_numScalerJobs = _nextScalerJob = 0;
+		SDL_UnlockMutex(_scalerMutex);
+	}
+
+	// Keep the allocated memory for the next frame
+	_scalerJobs.resize(0);
+}
+
+bool SurfaceSdlGraphicsManager::processScalerJob() {
+	if (_nextScalerJob >= _numScalerJobs)
+		return false;
+
+	// The job list is not changed while jobs are pending, so it can be
+	// accessed without holding the mutex.
+	const ScalerJob &job = _scalerJobs[_nextScalerJob++];
+	SDL_UnlockMutex(_scalerMutex);
+	_scalerJobProc(job.src, job.srcPitch, job.dst, job.dstPitch, job.width, job.height);
+	SDL_LockMutex(_scalerMutex);
+
+	if (--_pendingScalerJobs == 0)
+		SDL_CondSignal(_scalerDoneCond);
+	return true;
+}
+
 bool SurfaceSdlGraphicsManager::saveScreenshot(const char *filename) {
 	assert(_hwscreen != NULL);
 
@@ -1534,11 +1691,6 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool re
 	if (_forceFull)
 		return;
 
-	if (_numDirtyRects == NUM_DIRTY_RECT) {
-		_forceFull = true;
-		return;
-	}
-
 	int height, width;
 
 	if (!_overlayVisible && !realCoordinates) {
@@ -1577,20 +1729,154 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool re
 		h = height - y;
 	}
 
-#ifdef USE_SCALERS
-	if (_videoMode.aspectRatioCorrection && !_overlayVisible && !realCoordinates) {
-		makeRectStretchable(x, y, w, h);
-	}
-#endif
-
 	if (w == width && h == height) {
 		_forceFull = true;
 		return;
 	}
 
-	if (w > 0 && h > 0) {
+	if (w <= 0 || h <= 0)
+		return;
+
+	// Rects in real coordinates are added after the screen has been scaled
+	// (e.g. for the mouse cursor), so they go directly into the list.
+	if (realCoordinates) {
+		if (_numDirtyRects == NUM_DIRTY_RECT) {
+			_forceFull = true;
+			return;
+		}
+
 		SDL_Rect *r = &_dirtyRectList[_numDirtyRects++];
 
+		r->x = x;
+		r->y = y;
+		r->w = w;
+		r->h = h;
+		return;
+	}
+
+	const int tilesPitch = (width + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE;
+	const uint numTiles = tilesPitch * ((height + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE);
+	if (tilesPitch != _dirtyTilesPitch || numTiles != _dirtyTiles.size()) {
+		// The screen size changed, so the marked tiles are meaningless now
+		if (_hasDirtyTiles) {
+			_forceFull = true;
+			return;
+		}
+
+		_dirtyTiles.resize(numTiles);
+		memset(_dirtyTiles.begin(), 0, numTiles);
+		_dirtyTilesPitch = tilesPitch;
+	}
+
+	const int tileX1 = x / DIRTY_TILE_SIZE;
+	const int tileX2 = (x + w - 1) / DIRTY_TILE_SIZE;
+	byte *tile = &_dirtyTiles[(y / DIRTY_TILE_SIZE) * tilesPitch];
+	for (int tileY = y / DIRTY_TILE_SIZE; tileY <= (y + h - 1) / DIRTY_TILE_SIZE; ++tileY) {
+		memset(tile + tileX1, 1, tileX2 - tileX1 + 1);
+		tile += tilesPitch;
+	}
+	_hasDirtyTiles = true;
+}
+
+struct DirtyTileRun {
+	int x1, x2;
+	int rect;
+};
+
+void SurfaceSdlGraphicsManager::flushDirtyTiles() {
+	if (!_hasDirtyTiles)
+		return;
+
+	_hasDirtyTiles = false;
+
+	int height, width;
+
+	if (!_overlayVisible) {
+		width = _videoMode.screenWidth;
+		height = _videoMode.screenHeight;
+	} else {
+		width = _videoMode.overlayWidth;
+		height = _videoMode.overlayHeight;
+	}
+
+	// The overlay was shown or hidden after the tiles were marked. Screen
+	// and overlay may have the same width, so check the height as well.
+	const int expectedPitch = (width + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE;
+	const uint expectedTiles = expectedPitch * ((height + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE);
+	if (_dirtyTilesPitch != expectedPitch || _dirtyTiles.size() != expectedTiles)
+		_forceFull = true;
+
+	// Each horizontal run of dirty tiles in a tile row either extends the
+	// rect of a run with the same extent in the row above, or starts a new
+	// rect. The runs of the row above are kept in prevRuns, sorted by x.
+	Common::Array<DirtyTileRun> runs[2];
+	const int tilesPitch = _dirtyTilesPitch;
+	const int tilesRows = _dirtyTiles.size() / tilesPitch;
+	const int firstRect = _numDirtyRects;
+	// Keep one entry free for the mouse cursor
+	const int maxRects = NUM_DIRTY_RECT - 1;
+	byte *tiles = _dirtyTiles.begin();
+
+	for (int tileY = 0; tileY < tilesRows && !_forceFull; ++tileY, tiles += tilesPitch) {
+		const Common::Array<DirtyTileRun> &prevRuns = runs[(tileY + 1) & 1];
+		Common::Array<DirtyTileRun> &curRuns = runs[tileY & 1];
+		uint prev = 0;
+		curRuns.clear();
+
+		for (int tileX = 0; tileX < tilesPitch; ++tileX) {
+			if (!tiles[tileX])
+				continue;
+
+			DirtyTileRun run;
+			run.x1 = tileX;
+			while (tileX < tilesPitch && tiles[tileX])
+				++tileX;
+			run.x2 = tileX;
+
+			while (prev < prevRuns.size() && prevRuns[prev].x1 < run.x1)
+				++prev;
+
+			if (prev < prevRuns.size() && prevRuns[prev].x1 == run.x1 && prevRuns[prev].x2 == run.x2) {
+				run.rect = prevRuns[prev].rect;
+				_dirtyRectList[run.rect].h++;
+			} else if (_numDirtyRects < maxRects) {
+				run.rect = _numDirtyRects++;
+				SDL_Rect &r = _dirtyRectList[run.rect];
+				r.x = run.x1;
+				r.y = tileY;
+				r.w = run.x2 - run.x1;
+				r.h = 1;
+			} else {
+				_forceFull = true;
+				break;
+			}
+			curRuns.push_back(run);
+		}
+	}
+
+	memset(_dirtyTiles.begin(), 0, _dirtyTiles.size());
+
+	if (_forceFull)
+		return;
+
+	// Convert the rects from tiles to pixels
+	for (SDL_Rect *r = _dirtyRectList + firstRect; r != _dirtyRectList + _numDirtyRects; ++r) {
+		int x = r->x * DIRTY_TILE_SIZE;
+		int y = r->y * DIRTY_TILE_SIZE;
+		int w = MIN<int>(r->w * DIRTY_TILE_SIZE, width - x);
+		int h = MIN<int>(r->h * DIRTY_TILE_SIZE, height - y);
+
+#ifdef USE_SCALERS
+		if (_videoMode.aspectRatioCorrection && !_overlayVisible) {
+			makeRectStretchable(x, y, w, h);
+		}
+#endif
+
+		if (w == width && h == height) {
+			_forceFull = true;
+			return;
+		}
+
 		r->x = x;
 		r->y = y;
 		r->w = w;
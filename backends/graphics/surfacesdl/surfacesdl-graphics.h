@@ -27,6 +27,7 @@
 #include "backends/graphics/sdl/sdl-graphics.h"
 #include "graphics/pixelformat.h"
 #include "graphics/scaler.h"
+#include "common/array.h"
 #include "common/events.h"
 #include "common/system.h"
 
@@ -295,6 +296,51 @@ protected:
 	int _scalerType;
 	int _transactionMode;
 
+	/**
+	 * A part of the screen to be scaled. Large dirty rects are split into
+	 * horizontal bands, which are scaled concurrently by the scaler threads.
+	 */
+	struct ScalerJob {
+		const uint8 *src;
+		uint32 srcPitch;
+		uint8 *dst;
+		uint32 dstPitch;
+		int width, height;
+	};
+
+	enum {
+		// Bands are at least this many source lines high, since some scalers
+		// need at least a few lines per call (e.g. AdvMame4x).
+		MIN_SCALER_BAND_HEIGHT = 16,
+		MAX_SCALER_THREADS = 16
+	};
+
+	ScalerProc *_scalerJobProc;
+	Common::Array<ScalerJob> _scalerJobs;
+	uint _numScalerJobs, _nextScalerJob, _pendingScalerJobs;
+	SDL_mutex *_scalerMutex;
+	SDL_cond *_scalerWorkCond, *_scalerDoneCond;
+	Common::Array<SDL_Thread *> _scalerThreads;
+	bool _scalerThreadsShouldQuit;
+
+	/** Start the number of scaler threads set by the "scaler_threads" config key. */
+	void startScalerThreads();
+	void stopScalerThreads();
+
+	/**
+	 * Queue scaling a rect. It is split into bands if there are scaler
+	 * threads and splitIntoBands is set, which requires a reentrant scaler.
+	 */
+	void addScalerJob(const uint8 *src, uint32 srcPitch, uint8 *dst, uint32 dstPitch, int width, int height, int scaleFactor, bool splitIntoBands);
+
+	/** Scale all queued bands, and wait until all of them are done. */
+	void runScalerJobs(ScalerProc *scalerProc);
+
+	/** Take the next queued job and scale it. Called with _scalerMutex locked. */
+	bool processScalerJob();
+
+	static int SDLCALL scalerThreadEntry(void *arg);
+
 	// Indicates whether it is needed to free _hwsurface in destructor
 	bool _displayDisabled;
 
@@ -308,13 +354,21 @@ protected:
 
 	enum {
 		NUM_DIRTY_RECT = 100,
-		MAX_SCALING = 3
+		MAX_SCALING = 3,
+		DIRTY_TILE_SIZE = 16
 	};
 
 	// Dirty rect management
 	SDL_Rect _dirtyRectList[NUM_DIRTY_RECT];
 	int _numDirtyRects;
 
+	// Areas marked dirty by addDirtyRect(), as a map of tiles in the
+	// coordinates of the game screen or the overlay, whichever is visible.
+	// They are merged into _dirtyRectList by flushDirtyTiles().
+	Common::Array<byte> _dirtyTiles;
+	int _dirtyTilesPitch;
+	bool _hasDirtyTiles;
+
 	struct MousePos {
 		// The mouse position, using either virtual (game) or real
 		// (overlay) coordinates.
@@ -383,6 +437,13 @@ protected:
 
 	virtual void addDirtyRect(int x, int y, int w, int h, bool realCoordinates = false);
 
+	/**
+	 * Add the tiles marked by addDirtyRect() to the dirty rect list. Adjacent
+	 * tiles are merged into as few rects as possible. This has to be called
+	 * before the screen is redrawn from the dirty rect list.
+	 */
+	void flushDirtyTiles();
+
 	virtual void drawMouse();
 	virtual void undrawMouse();
 	virtual void blitCursor();
@@ -149,9 +149,7 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 	// Update file's timestamp
-	Common::HashMap<Common::String, uint32> timestamps = loadTimestamps();
-	timestamps[filename] = INVALID_TIMESTAMP;
-	saveTimestamps(timestamps);
+	updateTimestamp(filename, false);
 #endif
 
 	// Obtain node.
@@ -184,12 +182,7 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 	// Update file's timestamp
-	Common::HashMap<Common::String, uint32> timestamps = loadTimestamps();
-	Common::HashMap<Common::String, uint32>::iterator it = timestamps.find(filename);
-	if (it != timestamps.end()) {
-		timestamps.erase(it);
-		saveTimestamps(timestamps);
-	}
+	updateTimestamp(filename, true);
 #endif
 
 	// Obtain node if exists.
@@ -309,11 +302,18 @@ Common::HashMap<Common::String, uint32> DefaultSaveFileManager::loadTimestamps()
 		return timestamps;
 	}
 
-	while (!file->eos()) {
+	readTimestamps(*file, timestamps);
+
+	delete file;
+	return timestamps;
+}
+
+void DefaultSaveFileManager::readTimestamps(Common::SeekableReadStream &file, Common::HashMap<Common::String, uint32> &timestamps) {
+	while (!file.eos()) {
 		//read filename into buffer (reading until the first ' ')
 		Common::String buffer;
-		while (!file->eos()) {
-			byte b = file->readByte();
+		while (!file.eos()) {
+			byte b = file.readByte();
 			if (b == ' ') break;
 			buffer += (char)b;
 		}
@@ -323,8 +323,8 @@ Common::HashMap<Common::String, uint32> DefaultSaveFileManager::loadTimestamps()
 		while (true) {
 			bool lineEnded = false;
 			buffer = "";
-			while (!file->eos()) {
-				byte b = file->readByte();
+			while (!file.eos()) {
+				byte b = file.readByte();
 				if (b == ' ' || b == '\n' || b == '\r') {
 					lineEnded = (b == '\n');
 					break;
@@ -332,7 +332,7 @@ Common::HashMap<Common::String, uint32> DefaultSaveFileManager::loadTimestamps()
 				buffer += (char)b;
 			}
 
-			if (buffer == "" && file->eos()) break;
+			if (buffer == "" && file.eos()) break;
 			if (!lineEnded) filename += " " + buffer;
 			else break;
 		}
@@ -343,9 +343,37 @@ Common::HashMap<Common::String, uint32> DefaultSaveFileManager::loadTimestamps()
 		if (timestamps.contains(filename))
 			timestamps[filename] = timestamp;
 	}
+}
 
-	delete file;
-	return timestamps;
+void DefaultSaveFileManager::updateTimestamp(const Common::String &filename, bool remove) {
+	// Files which are not listed in the timestamps file count as changed
+	// anyway, so start with the files we already know about.
+	Common::HashMap<Common::String, uint32> timestamps;
+	for (SaveFileCache::const_iterator file = _saveFileCache.begin(), end = _saveFileCache.end(); file != end; ++file)
+		timestamps[file->_key] = INVALID_TIMESTAMP;
+
+	SaveFileCache::const_iterator file = _saveFileCache.find(TIMESTAMPS_FILENAME);
+	if (file != _saveFileCache.end()) {
+		Common::SeekableReadStream *stream = file->_value.createReadStream();
+		if (stream) {
+			readTimestamps(*stream, timestamps);
+			delete stream;
+		}
+	}
+
+	if (remove) {
+		if (!timestamps.contains(filename))
+			return;
+		timestamps.erase(filename);
+	} else {
+		timestamps[filename] = INVALID_TIMESTAMP;
+	}
+	saveTimestamps(timestamps);
+
+	// Make sure the timestamps file is found next time even if it was just
+	// created.
+	if (!_saveFileCache.contains(TIMESTAMPS_FILENAME))
+		_saveFileCache[TIMESTAMPS_FILENAME] = Common::FSNode(_cachedDirectory).getChild(TIMESTAMPS_FILENAME);
 }
 
 void DefaultSaveFileManager::saveTimestamps(Common::HashMap<Common::String, uint32> &timestamps) {
@@ -99,6 +99,22 @@ private:
 	 * The currently cached directory.
 	 */
 	Common::String _cachedDirectory;
+
+#if defined(USE_CLOUD) && defined(USE_LIBCURL)
+	/**
+	 * Read the timestamps file into the given map. Only entries for files
+	 * which are already contained in the map are taken over.
+	 */
+	static void readTimestamps(Common::SeekableReadStream &file, Common::HashMap<Common::String, uint32> &timestamps);
+
+	/**
+	 * Invalidate or remove the timestamp of a single file.
+	 *
+	 * Unlike loadTimestamps() this uses the current savefile cache
+	 * instead of listing the save directory again.
+	 */
+	void updateTimestamp(const Common::String &filename, bool remove);
+#endif
 };
 
 #endif
@@ -34,6 +34,12 @@ struct TimerSlot {
 	uint32 nextFireTime;	// in milliseconds
 	uint32 nextFireTimeMicro;	// microseconds part of nextFire
 
+	// Punctuality statistics, see Common::TimerManager::TimerStats
+	uint32 calls;
+	uint32 totalLateness;	// in milliseconds
+	uint32 maxLateness;	// in milliseconds
+	uint32 overruns;
+
 	TimerSlot *next;
 };
 
@@ -89,6 +95,15 @@ void DefaultTimerManager::handler() {
 		// Remove the slot from the priority queue
 		_head->next = slot->next;
 
+		// Record how late the timer fires. Being a whole interval late means
+		// that the timer will fire again right away to catch up.
+		const uint32 lateness = curTime - slot->nextFireTime;
+		slot->calls++;
+		slot->totalLateness += lateness;
+		slot->maxLateness = MAX(slot->maxLateness, lateness);
+		if (lateness * 1000 >= slot->interval)
+			slot->overruns++;
+
 		// Update the fire time and reinsert the TimerSlot into the priority
 		// queue.
 		assert(slot->interval > 0);
@@ -134,6 +149,10 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	slot->interval = interval;
 	slot->nextFireTime = g_system->getMillis() + interval / 1000;
 	slot->nextFireTimeMicro = interval % 1000;
+	slot->calls = 0;
+	slot->totalLateness = 0;
+	slot->maxLateness = 0;
+	slot->overruns = 0;
 	slot->next = 0;
 
 	insertPrioQueue(_head, slot);
@@ -173,3 +192,21 @@ void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 			_callbacks.erase(i);
 	}
 }
+
+Common::TimerManager::TimerStatsList DefaultTimerManager::getTimerStats() {
+	Common::StackLock lock(_mutex);
+
+	TimerStatsList list;
+	for (TimerSlot *slot = _head->next; slot; slot = slot->next) {
+		TimerStats stats;
+		stats.id = slot->id;
+		stats.interval = slot->interval;
+		stats.calls = slot->calls;
+		stats.totalLateness = slot->totalLateness;
+		stats.maxLateness = slot->maxLateness;
+		stats.overruns = slot->overruns;
+		list.push_back(stats);
+	}
+
+	return list;
+}
@@ -43,6 +43,7 @@ public:
 	virtual ~DefaultTimerManager();
 	virtual bool installTimerProc(TimerProc proc, int32 interval, void *refCon, const Common::String &id);
 	virtual void removeTimerProc(TimerProc proc);
+	virtual TimerStatsList getTimerStats();
 
 	/**
 	 * Timer callback, to be invoked at regular time intervals by the backend.
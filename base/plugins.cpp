@@ -445,6 +445,7 @@ void PluginManager::addToPluginsInMemList(Plugin *plugin) {
 // Engine plugins
 
 #include "engines/metaengine.h"
+#include "engines/advancedDetector.h"
 
 namespace Common {
 DECLARE_SINGLETON(EngineManager);
@@ -518,6 +519,9 @@ GameList EngineManager::detectGames(const Common::FSList &fslist) const {
 	GameList candidates;
 	EnginePlugin::List plugins;
 	EnginePlugin::List::const_iterator iter;
+	// Share the MD5s computed by one engine with all the others, since most
+	// of them look at the same files.
+	ADFilePropsCache.beginScan();
 	PluginManager::instance().loadFirstPlugin();
 	do {
 		plugins = getPlugins();
@@ -527,6 +531,7 @@ GameList EngineManager::detectGames(const Common::FSList &fslist) const {
 			candidates.push_back((**iter)->detectGames(fslist));
 		}
 	} while (PluginManager::instance().loadNextPlugin());
+	ADFilePropsCache.endScan();
 	return candidates;
 }
 
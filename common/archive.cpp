@@ -22,6 +22,7 @@
 
 #include "common/archive.h"
 #include "common/fs.h"
+#include "common/mutex.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -62,6 +63,8 @@ int Archive::listMatchingMembers(ArchiveMemberList &list, const String &pattern)
 
 
 
+uint32 SearchSet::_generation = 0;
+
 SearchSet::ArchiveNodeList::iterator SearchSet::find(const String &name) {
 	ArchiveNodeList::iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
@@ -92,6 +95,19 @@ void SearchSet::insert(const Node &node) {
 			break;
 	}
 	_list.insert(it, node);
+	flushLookupCaches();
+}
+
+SearchSet::SearchSet() : _lookupCacheGeneration(0), _lookupCacheHits(0), _lookupCacheMisses(0), _lookupCacheMutex(0) {
+	// Search sets can be used before there is an OSystem, e.g. by the
+	// unit tests. They are only used from a single thread then.
+	if (g_system)
+		_lookupCacheMutex = new Mutex();
+}
+
+SearchSet::~SearchSet() {
+	clear();
+	delete _lookupCacheMutex;
 }
 
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
@@ -173,6 +189,7 @@ void SearchSet::remove(const String &name) {
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
+		flushLookupCaches();
 	}
 }
 
@@ -187,6 +204,7 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	flushLookupCaches();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -205,17 +223,63 @@ void SearchSet::setPriority(const String &name, int priority) {
 	insert(node);
 }
 
-bool SearchSet::hasFile(const String &name) const {
-	if (name.empty())
-		return false;
+bool SearchSet::lookup(const String &name, Archive *&archive) const {
+	if (_lookupCacheMutex)
+		_lookupCacheMutex->lock();
+
+	if (_lookupCacheGeneration != _generation) {
+		_lookupCache.clear();
+		_lookupCacheGeneration = _generation;
+	}
+
+	LookupCache::const_iterator it = _lookupCache.find(name);
+	const bool found = (it != _lookupCache.end());
+	if (found) {
+		archive = it->_value;
+		_lookupCacheHits++;
+	} else {
+		_lookupCacheMisses++;
+	}
+
+	if (_lookupCacheMutex)
+		_lookupCacheMutex->unlock();
+	return found;
+}
+
+void SearchSet::addToLookupCache(const String &name, Archive *archive) const {
+	if (_lookupCacheMutex)
+		_lookupCacheMutex->lock();
+
+	// Do not store results which were found before the set was modified
+	if (_lookupCacheGeneration == _generation)
+		_lookupCache[name] = archive;
+
+	if (_lookupCacheMutex)
+		_lookupCacheMutex->unlock();
+}
+
+Archive *SearchSet::findArchive(const String &name) const {
+	Archive *archive = 0;
+	if (lookup(name, archive))
+		return archive;
 
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(name))
-			return true;
+		if (it->_arc->hasFile(name)) {
+			archive = it->_arc;
+			break;
+		}
 	}
 
-	return false;
+	addToLookupCache(name, archive);
+	return archive;
+}
+
+bool SearchSet::hasFile(const String &name) const {
+	if (name.empty())
+		return false;
+
+	return findArchive(name) != 0;
 }
 
 int SearchSet::listMatchingMembers(ArchiveMemberList &list, const String &pattern) const {
@@ -242,11 +306,9 @@ const ArchiveMemberPtr SearchSet::getMember(const String &name) const {
 	if (name.empty())
 		return ArchiveMemberPtr();
 
-	ArchiveNodeList::const_iterator it = _list.begin();
-	for (; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(name))
-			return it->_arc->getMember(name);
-	}
+	Archive *archive = findArchive(name);
+	if (archive)
+		return archive->getMember(name);
 
 	return ArchiveMemberPtr();
 }
@@ -255,11 +317,22 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const String &name) con
 	if (name.empty())
 		return 0;
 
+	// Only known members are taken from the lookup cache. An archive might
+	// still be able to open a file it does not report through hasFile().
+	Archive *cached = 0;
+	if (lookup(name, cached) && cached) {
+		SeekableReadStream *stream = cached->createReadStreamForMember(name);
+		if (stream)
+			return stream;
+	}
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		SeekableReadStream *stream = it->_arc->createReadStreamForMember(name);
-		if (stream)
+		if (stream) {
+			addToLookupCache(name, it->_arc);
 			return stream;
+		}
 	}
 
 	return 0;
@@ -24,6 +24,8 @@
 #define COMMON_ARCHIVE_H
 
 #include "common/str.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "common/ptr.h"
 #include "common/singleton.h"
@@ -31,6 +33,7 @@
 namespace Common {
 
 class FSNode;
+class Mutex;
 class SeekableReadStream;
 
 
@@ -146,8 +149,34 @@ class SearchSet : public Archive {
 	// Add an archive keeping the list sorted by descending priority.
 	void insert(const Node& node);
 
+	/**
+	 * Maps member names to the archive which provided them during an earlier
+	 * lookup, or to 0 if no archive has them. It is flushed whenever any
+	 * SearchSet is modified, since search sets may be nested.
+	 *
+	 * Lookups happen from const methods, which may be called from other
+	 * threads (e.g. timer callbacks), so the cache is guarded by a mutex.
+	 */
+	typedef HashMap<String, Archive *> LookupCache;
+	mutable LookupCache _lookupCache;
+	mutable uint32 _lookupCacheGeneration;
+	mutable uint32 _lookupCacheHits;
+	mutable uint32 _lookupCacheMisses;
+	Mutex *_lookupCacheMutex;
+
+	static uint32 _generation;
+
+	/**
+	 * Look up which archive provided a member before. Returns false if the
+	 * member is not in the lookup cache.
+	 */
+	bool lookup(const String &name, Archive *&archive) const;
+	void addToLookupCache(const String &name, Archive *archive) const;
+	Archive *findArchive(const String &name) const;
+
 public:
-	virtual ~SearchSet() { clear(); }
+	SearchSet();
+	virtual ~SearchSet();
 
 	/**
 	 * Add a new archive to the searchable set.
@@ -241,6 +270,22 @@ public:
 	 * opening the first file encountered that matches the name.
 	 */
 	virtual SeekableReadStream *createReadStreamForMember(const String &name) const;
+
+	/**
+	 * Forget which archives provided which members. This is done automatically
+	 * when archives are added or removed, but needs to be called explicitly
+	 * if the content of an archive in the set changes.
+	 */
+	static void flushLookupCaches() { _generation++; }
+
+	/**
+	 * Get the number of member lookups answered from the lookup cache and the
+	 * number of lookups which had to query the archives.
+	 */
+	void getLookupCacheStats(uint32 &hits, uint32 &misses) const {
+		hits = _lookupCacheHits;
+		misses = _lookupCacheMisses;
+	}
 };
 
 
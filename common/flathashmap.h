@@ -0,0 +1,492 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_FLATHASHMAP_H
+#define COMMON_FLATHASHMAP_H
+
+#include "common/scummsys.h"
+#include "common/func.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+/**
+ * FlatHashMap<Key,Val> is an alternative to HashMap<Key,Val> with the same
+ * interface, which stores its keys and values inline in one contiguous
+ * array instead of allocating a node for every entry.
+ *
+ * Collisions are resolved by linear probing. Erased entries do not leave
+ * tombstones behind: the following entries of the probe sequence are moved
+ * back instead ("backward shift deletion"), so lookups never slow down after
+ * many insertions and removals.
+ *
+ * There are two differences to HashMap which callers must be aware of:
+ * - Pointers and references to values are invalidated whenever the map
+ *   grows, since the values live inside the table.
+ * - Erasing an entry may move other entries around, which invalidates all
+ *   iterators. Code which removes entries while iterating over the map has
+ *   to collect the keys to remove first.
+ *
+ * Key and Val must be copy constructible and assignable.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+private:
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	struct Node {
+		Key _key;
+		Val _value;
+		explicit Node(const Key &key) : _key(key), _value() {}
+		Node(const Key &key, const Val &value) : _key(key), _value(value) {}
+	};
+
+	enum {
+		FLATHASHMAP_MIN_CAPACITY = 16,
+
+		// The quotient of the next two constants controls how much the
+		// internal storage may fill up before being increased automatically.
+		// Linear probing degrades quickly at high load, hence the quotient
+		// is lower than the one used by HashMap.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 5,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 8
+	};
+
+	Node *_storage;     ///< Table of capacity (_mask + 1) entries, only those marked in _used are constructed.
+	byte *_used;        ///< For every entry in _storage, whether it is occupied.
+	size_type _mask;    ///< Capacity of the table minus one; the capacity is always a power of two.
+	size_type _shift;   ///< 32 minus log2 of the capacity, used to pick the home slot.
+	size_type _size;
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	/** Default value, returned by the const getVal. */
+	const Val _defaultVal;
+
+	/**
+	 * Compute the home slot of a hash value. The hash is scrambled with a
+	 * multiplicative (Fibonacci) hash first, since many of our hash
+	 * functions are the identity on integers, and linear probing does not
+	 * cope well with keys that are all multiples of some power of two.
+	 */
+	size_type homeSlot(uint hash) const {
+		return (size_type)((uint32)(hash * 2654435769U) >> _shift) & _mask;
+	}
+
+	void allocStorage(size_type capacity);
+	void freeStorage();
+	void assign(const FHM_t &map);
+	size_type lookup(const Key &key) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	void insertNode(const Node &node);
+	void expandStorage(size_type newCapacity);
+	void eraseAt(size_type idx);
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType, class MapType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T, class U> friend class IteratorImpl;
+	protected:
+		size_type _idx;
+		MapType *_map;
+
+		IteratorImpl(size_type idx, MapType *map) : _idx(idx), _map(map) {}
+
+		NodeType *deref() const {
+			assert(_map != 0);
+			assert(_idx <= _map->_mask);
+			assert(_map->_used[_idx]);
+			return &_map->_storage[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _map(0) {}
+		template<class T, class U>
+		IteratorImpl(const IteratorImpl<T, U> &c) : _idx(c._idx), _map(c._map) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _map == iter._map; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_map);
+			do {
+				_idx++;
+			} while (_idx <= _map->_mask && !_map->_used[_idx]);
+			if (_idx > _map->_mask)
+				_idx = (size_type)-1;
+
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+	size_type firstUsed() const {
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (_used[ctr])
+				return ctr;
+		}
+		return (size_type)-1;
+	}
+
+public:
+	typedef IteratorImpl<Node, FHM_t> iterator;
+	typedef IteratorImpl<const Node, const FHM_t> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		clear();
+		freeStorage();
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const;
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getVal(const Key &key, const Val &defaultVal) const;
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	iterator begin() { return iterator(firstUsed(), this); }
+	iterator end() { return iterator((size_type)-1, this); }
+
+	const_iterator begin() const { return const_iterator(firstUsed(), this); }
+	const_iterator end() const { return const_iterator((size_type)-1, this); }
+
+	iterator find(const Key &key) {
+		size_type ctr = lookup(key);
+		if (_used[ctr])
+			return iterator(ctr, this);
+		return end();
+	}
+
+	const_iterator find(const Key &key) const {
+		size_type ctr = lookup(key);
+		if (_used[ctr])
+			return const_iterator(ctr, this);
+		return end();
+	}
+
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Base constructor, creates an empty map.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+}
+
+/**
+ * Copy constructor, creates a full copy of the given map.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) : _defaultVal() {
+	assign(map);
+}
+
+/**
+ * Destructor, frees all used memory.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	clear();
+	freeStorage();
+}
+
+/**
+ * Internal method for allocating an empty table of the given capacity,
+ * which must be a power of two. The previous table, if any, is not freed.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocStorage(size_type capacity) {
+	assert(capacity >= FLATHASHMAP_MIN_CAPACITY && (capacity & (capacity - 1)) == 0);
+
+	_storage = (Node *)malloc(capacity * sizeof(Node));
+	_used = (byte *)calloc(capacity, sizeof(byte));
+	if (!_storage || !_used)
+		::error("FlatHashMap: failure to allocate %u bytes", capacity * (uint)(sizeof(Node) + 1));
+
+	_mask = capacity - 1;
+	_shift = 32;
+	while (capacity > 1) {
+		capacity >>= 1;
+		_shift--;
+	}
+	_size = 0;
+}
+
+/**
+ * Internal method for releasing the table. All entries must have been
+ * destructed before.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::freeStorage() {
+	free(_storage);
+	free(_used);
+	_storage = 0;
+	_used = 0;
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note We do *not* deallocate the previous storage here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// The slot of every key only depends on the capacity, so the entries
+	// can simply be copied over one by one.
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (map._used[ctr]) {
+			new ((void *)&_storage[ctr]) Node(map._storage[ctr]);
+			_used[ctr] = 1;
+			_size++;
+		}
+	}
+	assert(_size == map._size);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (_used[ctr]) {
+			_storage[ctr].~Node();
+			_used[ctr] = 0;
+		}
+	}
+	_size = 0;
+
+	if (shrinkArray && _mask + 1 > FLATHASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	}
+}
+
+/**
+ * Internal method for placing a node into the table. The key must not be
+ * present yet, and there must be room for it.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::insertNode(const Node &node) {
+	size_type idx = homeSlot(_hash(node._key));
+	while (_used[idx])
+		idx = (idx + 1) & _mask;
+
+	new ((void *)&_storage[idx]) Node(node);
+	_used[idx] = 1;
+	_size++;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::expandStorage(size_type newCapacity) {
+	assert(newCapacity > _mask + 1);
+
+	const size_type oldSize = _size;
+	const size_type oldMask = _mask;
+	Node *oldStorage = _storage;
+	byte *oldUsed = _used;
+
+	allocStorage(newCapacity);
+
+	// Rehash all the old elements. Since we know that no key exists twice
+	// in the old table, we don't have to call _equal().
+	for (size_type ctr = 0; ctr <= oldMask; ++ctr) {
+		if (!oldUsed[ctr])
+			continue;
+
+		insertNode(oldStorage[ctr]);
+		oldStorage[ctr].~Node();
+	}
+
+	// Perform a sanity check: Old number of elements should match the new one!
+	// This check will fail if some previous operation corrupted this map.
+	assert(_size == oldSize);
+	(void)oldSize;
+
+	free(oldStorage);
+	free(oldUsed);
+}
+
+/**
+ * Find the slot containing the given key, or the free slot which ends its
+ * probe sequence if the key is not present.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key) const {
+	size_type ctr = homeSlot(_hash(key));
+	while (_used[ctr] && !_equal(_storage[ctr]._key, key))
+		ctr = (ctr + 1) & _mask;
+
+	return ctr;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	size_type ctr = lookup(key);
+	if (_used[ctr])
+		return ctr;
+
+	// Keep the load factor below a certain threshold.
+	size_type capacity = _mask + 1;
+	if ((_size + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR) {
+		capacity = capacity < 500 ? (capacity * 4) : (capacity * 2);
+		expandStorage(capacity);
+		ctr = lookup(key);
+		assert(!_used[ctr]);
+	}
+
+	new ((void *)&_storage[ctr]) Node(key);
+	_used[ctr] = 1;
+	_size++;
+
+	return ctr;
+}
+
+/**
+ * Remove the entry at idx and move back the following entries of the probe
+ * sequence, so that no gap (and thus no tombstone) is left behind. This is
+ * algorithm R from Knuth's TAOCP, section 6.4.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::eraseAt(size_type idx) {
+	assert(idx <= _mask && _used[idx]);
+
+	size_type hole = idx;
+	for (size_type next = (hole + 1) & _mask; _used[next]; next = (next + 1) & _mask) {
+		// An entry has to stay where it is if its home slot lies cyclically
+		// in (hole, next], since it would not be found in the hole.
+		const size_type home = homeSlot(_hash(_storage[next]._key));
+		const bool stays = (hole <= next) ? (hole < home && home <= next) : (hole < home || home <= next);
+		if (stays)
+			continue;
+
+		_storage[hole] = _storage[next];
+		hole = next;
+	}
+
+	_storage[hole].~Node();
+	_used[hole] = 0;
+	_size--;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::contains(const Key &key) const {
+	return _used[lookup(key)] != 0;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	return _storage[ctr]._value;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	return getVal(key, _defaultVal);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key, const Val &defaultVal) const {
+	size_type ctr = lookup(key);
+	if (_used[ctr])
+		return _storage[ctr]._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	_storage[ctr]._value = val;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._map == this);
+	eraseAt(entry._idx);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (_used[ctr])
+		eraseAt(ctr);
+}
+
+} // End of namespace Common
+
+#endif
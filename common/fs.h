@@ -222,6 +222,16 @@ public:
 	 */
 	virtual SeekableReadStream *createReadStream() const;
 
+	/**
+	 * Creates a SeekableReadStream instance for read-only game data. On some
+	 * backends, large files are mapped into memory instead of being read, so
+	 * the file must not be modified while the stream exists. Otherwise this
+	 * behaves like createReadStream().
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	SeekableReadStream *createMappedReadStream() const;
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -279,6 +289,7 @@ class FSDirectory : public Archive {
 	mutable bool _cached;
 	mutable int	_depth;
 	mutable bool _flat;
+	bool _mapFiles;
 
 	// look for a match
 	FSNode *lookupCache(NodeCache &cache, const String &name) const;
@@ -314,6 +325,12 @@ public:
 	 */
 	FSNode getFSNode() const;
 
+	/**
+	 * Open members with FSNode::createMappedReadStream(). Only use this for
+	 * read-only game data, which is not modified while it is being used.
+	 */
+	void setMapFiles(bool mapFiles) { _mapFiles = mapFiles; }
+
 	/**
 	 * Create a new FSDirectory pointing to a sub directory of the instance. See class comment
 	 * for an explanation of the prefix parameter.
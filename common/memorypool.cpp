@@ -21,6 +21,7 @@
  */
 
 #include "common/memorypool.h"
+#include "common/mutex.h"
 #include "common/util.h"
 
 namespace Common {
@@ -117,6 +118,13 @@ bool MemoryPool::isPointerInPage(void *ptr, const Page &page) {
 	return (ptr >= page.start) && (ptr < (char *)page.start + page.numChunks * _chunkSize);
 }
 
+size_t MemoryPool::getNumAllocatedChunks() const {
+	size_t numChunks = 0;
+	for (size_t i = 0; i < _pages.size(); ++i)
+		numChunks += _pages[i].numChunks;
+	return numChunks;
+}
+
 void MemoryPool::freeUnusedPages() {
 	//std::sort(_pages.begin(), _pages.end());
 	Array<size_t> numberOfFreeChunksPerPage;
@@ -179,4 +187,92 @@ void MemoryPool::freeUnusedPages() {
 	}
 }
 
+DECLARE_SINGLETON(SharedMemoryPool);
+
+SharedMemoryPool::SharedMemoryPool() : _mutex(0) {
+	for (int i = 0; i < kNumSizeClasses; ++i)
+		_pools[i] = new MemoryPool((i + 1) * kGranularity);
+
+	for (int i = 0; i <= kNumSizeClasses; ++i) {
+		_allocations[i] = 0;
+		_inUse[i] = 0;
+	}
+
+	// The backend might not be set up yet, e.g. when running the tests.
+	if (g_system)
+		_mutex = new Mutex();
+}
+
+SharedMemoryPool::~SharedMemoryPool() {
+	for (int i = 0; i < kNumSizeClasses; ++i)
+		delete _pools[i];
+
+	delete _mutex;
+}
+
+void *SharedMemoryPool::allocate(size_t size) {
+	const size_t sizeClass = size ? (size - 1) / kGranularity : 0;
+
+	if (_mutex)
+		_mutex->lock();
+
+	void *ptr;
+	if (sizeClass < kNumSizeClasses) {
+		ptr = _pools[sizeClass]->allocChunk();
+		++_allocations[sizeClass];
+		++_inUse[sizeClass];
+	} else {
+		ptr = ::malloc(size);
+		++_allocations[kNumSizeClasses];
+		++_inUse[kNumSizeClasses];
+	}
+
+	if (_mutex)
+		_mutex->unlock();
+
+	return ptr;
+}
+
+void SharedMemoryPool::free(void *ptr, size_t size) {
+	if (!ptr)
+		return;
+
+	const size_t sizeClass = size ? (size - 1) / kGranularity : 0;
+
+	if (_mutex)
+		_mutex->lock();
+
+	if (sizeClass < kNumSizeClasses) {
+		_pools[sizeClass]->freeChunk(ptr);
+		--_inUse[sizeClass];
+	} else {
+		::free(ptr);
+		--_inUse[kNumSizeClasses];
+	}
+
+	if (_mutex)
+		_mutex->unlock();
+}
+
+Array<SharedMemoryPool::SizeClassStats> SharedMemoryPool::getStats() {
+	Array<SizeClassStats> stats;
+
+	if (_mutex)
+		_mutex->lock();
+
+	for (int i = 0; i <= kNumSizeClasses; ++i) {
+		SizeClassStats entry;
+		entry.chunkSize = (i < kNumSizeClasses) ? _pools[i]->getChunkSize() : 0;
+		entry.allocations = _allocations[i];
+		entry.inUse = _inUse[i];
+		entry.numChunks = (i < kNumSizeClasses) ? _pools[i]->getNumAllocatedChunks() : 0;
+		stats.push_back(entry);
+	}
+
+	if (_mutex)
+		_mutex->unlock();
+
+	return stats;
+}
+
 } // End of namespace Common
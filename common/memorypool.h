@@ -25,6 +25,7 @@
 
 #include "common/scummsys.h"
 #include "common/array.h"
+#include "common/singleton.h"
 
 
 namespace Common {
@@ -94,6 +95,12 @@ public:
 	 * Return the chunk size used by this memory pool.
 	 */
 	size_t	getChunkSize() const { return _chunkSize; }
+
+	/**
+	 * Return the number of chunks in the pages allocated by this memory
+	 * pool. Static storage added by subclasses is not included.
+	 */
+	size_t	getNumAllocatedChunks() const;
 };
 
 /**
@@ -141,8 +148,67 @@ public:
 	}
 };
 
+class Mutex;
+
+/**
+ * A memory pool for blocks of different sizes, which may be used from
+ * multiple threads, e.g. for objects which are created by the engine
+ * and destroyed in the audio thread.
+ *
+ * Requests are rounded up to a multiple of kGranularity and served by a
+ * MemoryPool for that size class. Larger blocks are allocated via
+ * malloc. Since the pool does not store the size of a block, the same
+ * size has to be passed to both allocate() and free(), which is what the
+ * class specific operator new and delete receive.
+ */
+class SharedMemoryPool : public Singleton<SharedMemoryPool> {
+public:
+	enum {
+		kGranularity = 16,
+		kNumSizeClasses = 16,
+		kMaxPooledSize = kGranularity * kNumSizeClasses
+	};
+
+	struct SizeClassStats {
+		size_t chunkSize;       ///< size of the blocks of this class
+		uint32 allocations;     ///< number of blocks allocated so far
+		uint32 inUse;           ///< number of blocks currently allocated
+		size_t numChunks;       ///< number of blocks the pool has memory for
+	};
+
+	/**
+	 * Allocate a block of the given size.
+	 */
+	void *allocate(size_t size);
+
+	/**
+	 * Free a block obtained via allocate(). The size has to match the size
+	 * passed to allocate().
+	 */
+	void free(void *ptr, size_t size);
+
+	/**
+	 * Get statistics of all size classes. The last entry covers the blocks
+	 * too large for the pool, with chunkSize and numChunks set to 0.
+	 */
+	Array<SizeClassStats> getStats();
+
+private:
+	friend class Singleton<SharedMemoryPool>;
+	SharedMemoryPool();
+	~SharedMemoryPool();
+
+	MemoryPool *_pools[kNumSizeClasses];
+	uint32 _allocations[kNumSizeClasses + 1];
+	uint32 _inUse[kNumSizeClasses + 1];
+	Mutex *_mutex;
+};
+
 } // End of namespace Common
 
+/** Shortcut for accessing the shared memory pool. */
+#define SharedMemPool		Common::SharedMemoryPool::instance()
+
 /**
  * A custom placement new operator, using an arbitrary MemoryPool.
  *
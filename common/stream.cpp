@@ -261,6 +261,16 @@ bool SeekableSubReadStream::seek(int32 offset, int whence) {
 	return ret;
 }
 
+const byte *SeekableSubReadStream::getDirectPointer() const {
+	const byte *parentPtr = _parentStream->getDirectPointer();
+	if (!parentPtr)
+		return 0;
+
+	// The parent may have been repositioned by someone else (see
+	// SafeSeekableSubReadStream), so do not rely on its position.
+	return parentPtr - _parentStream->pos() + _pos;
+}
+
 uint32 SafeSeekableSubReadStream::read(void *dataPtr, uint32 dataSize) {
 	// Make sure the parent stream is at the right position
 	seek(0, SEEK_CUR);
@@ -527,6 +527,21 @@ public:
 	 */
 	virtual bool skip(uint32 offset) { return seek(offset, SEEK_CUR); }
 
+	/**
+	 * Returns a pointer to the data at the current stream position, for
+	 * streams which keep their whole content in memory (including memory
+	 * mapped files). This allows callers to parse data in place instead of
+	 * copying it into a buffer of their own first.
+	 *
+	 * The pointer stays valid for as long as the stream exists, and
+	 * size() - pos() bytes may be accessed through it. The stream position
+	 * is not changed.
+	 *
+	 * @return a pointer to the data at the current position, or 0 if the
+	 *         stream does not support direct access
+	 */
+	virtual const byte *getDirectPointer() const { return 0; }
+
 	/**
 	 * Reads at most one less than the number of characters specified
 	 * by bufSize from the and stores them in the string buf. Reading
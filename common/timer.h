@@ -24,6 +24,7 @@
 #define COMMON_TIMER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/str.h"
 #include "common/noncopyable.h"
 
@@ -55,6 +56,26 @@ public:
 	 * and no instance of this callback will be running anymore.
 	 */
 	virtual void removeTimerProc(TimerProc proc) = 0;
+
+	/**
+	 * Punctuality statistics of an installed timer callback.
+	 */
+	struct TimerStats {
+		String id;              ///< id the timer was installed with
+		int32 interval;         ///< requested interval in microseconds
+		uint32 calls;           ///< number of invocations so far
+		uint32 totalLateness;   ///< sum of the delays of all invocations behind their schedule, in milliseconds
+		uint32 maxLateness;     ///< largest delay of an invocation behind its schedule, in milliseconds
+		uint32 overruns;        ///< number of invocations which were a whole interval or more late
+	};
+
+	typedef Array<TimerStats> TimerStatsList;
+
+	/**
+	 * Get the punctuality statistics of all installed timer callbacks.
+	 * Timer managers which do not keep statistics return an empty list.
+	 */
+	virtual TimerStatsList getTimerStats() { return TimerStatsList(); }
 };
 
 } // End of namespace Common
@@ -106,6 +106,9 @@ typedef struct {
 #include "common/fs.h"
 #include "common/unzip.h"
 #include "common/memstream.h"
+#include "common/textconsole.h"
+#include "common/substream.h"
+#include "common/zlib.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -1419,12 +1422,68 @@ int unzGetGlobalComment(unzFile file, char *szComment, uLong uSizeBuf) {
 
 namespace Common {
 
+/**
+ * Members at least this large are read directly from the archive instead
+ * of being decompressed into memory when they are opened.
+ */
+static const uint32 kStreamedMemberMinSize = 64 * 1024;
+
+#ifdef USE_ZLIB
+/**
+ * Verifies the CRC of a member which is read straight from the archive.
+ * The checksum is updated as long as the member is read sequentially, so
+ * seeking ahead skips the check. Reading the data again after seeking
+ * backwards does not.
+ */
+class ZipMemberCRCReadStream : public SeekableReadStream {
+	SeekableReadStream *_parentStream;
+	const uint32 _expectedCRC;
+	uLong _crc;
+	uint32 _checkedSize;
+	bool _crcError;
+
+public:
+	ZipMemberCRCReadStream(SeekableReadStream *parentStream, uint32 expectedCRC)
+		: _parentStream(parentStream), _expectedCRC(expectedCRC), _crc(crc32(0, Z_NULL, 0)), _checkedSize(0), _crcError(false) {
+	}
+
+	~ZipMemberCRCReadStream() {
+		delete _parentStream;
+	}
+
+	virtual bool err() const { return _crcError || _parentStream->err(); }
+	virtual void clearErr() { _parentStream->clearErr(); }
+	virtual bool eos() const { return _parentStream->eos(); }
+	virtual int32 pos() const { return _parentStream->pos(); }
+	virtual int32 size() const { return _parentStream->size(); }
+	virtual bool seek(int32 offset, int whence = SEEK_SET) { return _parentStream->seek(offset, whence); }
+
+	virtual uint32 read(void *dataPtr, uint32 dataSize) {
+		const uint32 start = _parentStream->pos();
+		const uint32 bytesRead = _parentStream->read(dataPtr, dataSize);
+
+		if (start <= _checkedSize && start + bytesRead > _checkedSize) {
+			const uint32 skip = _checkedSize - start;
+			_crc = crc32(_crc, (const Bytef *)dataPtr + skip, bytesRead - skip);
+			_checkedSize = start + bytesRead;
+
+			if (_checkedSize == (uint32)_parentStream->size() && _crc != _expectedCRC) {
+				warning("ZipMemberCRCReadStream: CRC mismatch");
+				_crcError = true;
+			}
+		}
+
+		return bytesRead;
+	}
+};
+#endif
 
 class ZipArchive : public Archive {
 	unzFile _zipFile;
+	ArchiveMemberPtr _source;
 
 public:
-	ZipArchive(unzFile zipFile);
+	ZipArchive(unzFile zipFile, const ArchiveMemberPtr &source);
 
 
 	~ZipArchive();
@@ -1453,7 +1512,7 @@ public:
 };
 */
 
-ZipArchive::ZipArchive(unzFile zipFile) : _zipFile(zipFile) {
+ZipArchive::ZipArchive(unzFile zipFile, const ArchiveMemberPtr &source) : _zipFile(zipFile), _source(source) {
 	assert(_zipFile);
 }
 
@@ -1496,6 +1555,33 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) co
 	if (unzGetCurrentFileInfo(_zipFile, &fileInfo, NULL, 0, NULL, 0, NULL, 0) != UNZ_OK)
 		return 0;
 
+	// Large members are read straight from the archive, so opening them
+	// does not require decompressing them completely into memory. Every
+	// such member gets its own handle to the archive file, since members
+	// may be read from other threads, e.g. by audio streams.
+	if (fileInfo.uncompressed_size >= kStreamedMemberMinSize && _source) {
+		const unz_s *const archive = (const unz_s *)_zipFile;
+		const uint32 begin = archive->pfile_in_zip_read->pos_in_zipfile + archive->pfile_in_zip_read->byte_before_the_zipfile;
+
+		unzCloseCurrentFile(_zipFile);
+
+		SeekableReadStream *const archiveStream = _source->createReadStream();
+		if (!archiveStream)
+			return 0;
+
+		SeekableReadStream *member = new SeekableSubReadStream(archiveStream, begin, begin + fileInfo.compressed_size, DisposeAfterUse::YES);
+		if (fileInfo.compression_method != 0) {
+			member = wrapDeflateReadStream(member, fileInfo.uncompressed_size);
+			if (!member)
+				return 0;
+		}
+
+#ifdef USE_ZLIB
+		member = new ZipMemberCRCReadStream(member, fileInfo.crc);
+#endif
+		return member;
+	}
+
 	byte *buffer = (byte *)malloc(fileInfo.uncompressed_size);
 	assert(buffer);
 
@@ -1510,22 +1596,9 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) co
 	}
 
 	return new MemoryReadStream(buffer, fileInfo.uncompressed_size, DisposeAfterUse::YES);
-
-	// FIXME: instead of reading all into a memory stream, we could
-	// instead create a new ZipStream class. But then we have to be
-	// careful to handle the case where the client code opens multiple
-	// files in the archive and tries to use them independently.
-}
-
-Archive *makeZipArchive(const String &name) {
-	return makeZipArchive(SearchMan.createReadStreamForMember(name));
 }
 
-Archive *makeZipArchive(const FSNode &node) {
-	return makeZipArchive(node.createReadStream());
-}
-
-Archive *makeZipArchive(SeekableReadStream *stream) {
+static Archive *makeZipArchive(SeekableReadStream *stream, const ArchiveMemberPtr &source) {
 	if (!stream)
 		return 0;
 	unzFile zipFile = unzOpen(stream);
@@ -1534,7 +1607,25 @@ Archive *makeZipArchive(SeekableReadStream *stream) {
 		// goes wrong.
 		return 0;
 	}
-	return new ZipArchive(zipFile);
+	return new ZipArchive(zipFile, source);
+}
+
+Archive *makeZipArchive(const String &name) {
+	return makeZipArchive(SearchMan.getMember(name));
+}
+
+Archive *makeZipArchive(const FSNode &node) {
+	return makeZipArchive(ArchiveMemberPtr(new FSNode(node)));
+}
+
+Archive *makeZipArchive(const ArchiveMemberPtr &member) {
+	if (!member)
+		return 0;
+	return makeZipArchive(member->createReadStream(), member);
+}
+
+Archive *makeZipArchive(SeekableReadStream *stream) {
+	return makeZipArchive(stream, ArchiveMemberPtr());
 }
 
 } // End of namespace Common
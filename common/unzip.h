@@ -23,11 +23,11 @@
 #ifndef COMMON_UNZIP_H
 #define COMMON_UNZIP_H
 
+#include "common/archive.h"
 #include "common/str.h"
 
 namespace Common {
 
-class Archive;
 class FSNode;
 class SeekableReadStream;
 
@@ -47,11 +47,22 @@ Archive *makeZipArchive(const String &name);
  */
 Archive *makeZipArchive(const FSNode &node);
 
+/**
+ * This factory method creates an Archive instance corresponding to the content
+ * of the given ZIP compressed archive member.
+ * Large members of the ZIP archive are read from their own stream of the
+ * archive member, so they can be used independently of each other.
+ *
+ * May return 0 in case of a failure.
+ */
+Archive *makeZipArchive(const ArchiveMemberPtr &member);
+
 /**
  * This factory method creates an Archive instance corresponding to the content
  * of the given ZIP compressed datastream.
  * This takes ownership of the stream,  in particular, it is deleted when the
- * ZipArchive is deleted.
+ * ZipArchive is deleted. Since the stream cannot be reopened, all members are
+ * decompressed into memory when they are opened.
  *
  * May return 0 in case of a failure. In this case stream will still be deleted.
  */
@@ -32,6 +32,9 @@ XMLParser::~XMLParser() {
 	while (!_activeKey.empty())
 		freeNode(_activeKey.pop());
 
+	while (!_freeNodes.empty())
+		_nodePool.deleteChunk(_freeNodes.pop());
+
 	delete _XMLkeys;
 	delete _stream;
 
@@ -169,7 +172,7 @@ bool XMLParser::parseActiveKey(bool closed) {
 	if (layout->children.contains(key->name)) {
 		key->layout = layout->children[key->name];
 
-		StringMap localMap = key->values;
+		const StringMap &localMap = key->values;
 		int keyCount = localMap.size();
 
 		for (List<XMLKeyLayout::XMLKeyProperty>::const_iterator i = key->layout->properties.begin(); i != key->layout->properties.end(); ++i) {
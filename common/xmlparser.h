@@ -145,12 +145,22 @@ public:
 
 	ObjectPool<ParserNode, MAX_XML_DEPTH> _nodePool;
 
+	/**
+	 * Closed nodes. They are reused for the following keys, so that the
+	 * storage of their value maps does not need to be allocated again.
+	 */
+	Stack<ParserNode *> _freeNodes;
+
 	ParserNode *allocNode() {
+		if (!_freeNodes.empty())
+			return _freeNodes.pop();
+
 		return new (_nodePool) ParserNode;
 	}
 
 	void freeNode(ParserNode *node) {
-		_nodePool.deleteChunk(node);
+		node->values.clear();
+		_freeNodes.push(node);
 	}
 
 	/**
@@ -24,6 +24,7 @@
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
 #include "common/zlib.h"
+#include "common/array.h"
 #include "common/ptr.h"
 #include "common/util.h"
 #include "common/stream.h"
@@ -40,6 +41,12 @@
   #if ZLIB_VERNUM < 0x1204
   #error Version 1.2.0.4 or newer of zlib is required for this code
   #endif
+
+  // inflateGetDictionary, which is needed to create access points for
+  // seeking in compressed streams, was added in zlib 1.2.7.1.
+  #if ZLIB_VERNUM >= 0x1271
+  #define USE_GZIP_ACCESS_POINTS
+  #endif
 #endif
 
 
@@ -148,12 +155,31 @@ static bool _shownBackwardSeekingWarning = false;
 /**
  * A simple wrapper class which can be used to wrap around an arbitrary
  * other SeekableReadStream and will then provide on-the-fly decompression support.
- * Assumes the compressed data to be in gzip format.
+ * Assumes the compressed data to be in gzip or zlib format, or to be raw
+ * deflate data if isRawDeflate is set.
+ *
+ * While reading, access points are recorded at deflate block boundaries
+ * roughly every _accessPointSpan bytes of decompressed data. Each of them
+ * stores the inflate window at that position, so that seeking, in
+ * particular backwards, can resume decompression from the nearest access
+ * point instead of the start of the stream.
  */
 class GZipReadStream : public SeekableReadStream {
 protected:
 	enum {
-		BUFSIZE = 16384		// 1 << MAX_WBITS
+		BUFSIZE = 16384,		// 1 << MAX_WBITS
+		WINDOWSIZE = 32768,		// 1 << MAX_WBITS
+
+		// Initial distance of the access points in the decompressed data
+		ACCESS_POINT_SPAN = 256 * 1024
+	};
+
+	struct AccessPoint {
+		uint32 outPos;		///< position in the decompressed data
+		uint32 inPos;		///< position of the next complete byte in the wrapped stream
+		int bits;			///< number of bits of the byte before inPos which still need to be read
+		uint windowSize;	///< size of the window
+		byte *window;		///< the last decompressed data before outPos
 	};
 
 	byte	_buf[BUFSIZE];
@@ -164,16 +190,25 @@ protected:
 	uint32 _pos;
 	uint32 _origSize;
 	bool _eos;
+	int _windowBits;
+
+	Array<AccessPoint> _accessPoints;
+	uint32 _accessPointSpan;
+	// Maximum number of access points. When it is reached, every other
+	// access point is dropped and the span is doubled, so that the windows
+	// stay within the memory budget of the stream.
+	uint _maxAccessPoints;
 
 public:
 
-	GZipReadStream(SeekableReadStream *w, uint32 knownSize = 0) : _wrapped(w), _stream() {
+	GZipReadStream(SeekableReadStream *w, uint32 knownSize = 0, bool isRawDeflate = false, uint32 accessPointMemory = kDefaultAccessPointMemory)
+		: _wrapped(w), _stream(), _accessPointSpan(ACCESS_POINT_SPAN), _maxAccessPoints(accessPointMemory / WINDOWSIZE) {
 		assert(w != 0);
 
 		// Verify file header is correct
 		w->seek(0, SEEK_SET);
-		uint16 header = w->readUint16BE();
-		assert(header == 0x1F8B ||
+		uint16 header = isRawDeflate ? 0 : w->readUint16BE();
+		assert(isRawDeflate || header == 0x1F8B ||
 		       ((header & 0x0F00) == 0x0800 && header % 31 == 0));
 
 		if (header == 0x1F8B) {
@@ -181,7 +216,7 @@ public:
 			w->seek(-4, SEEK_END);
 			_origSize = w->readUint32LE();
 		} else {
-			// Original size not available in zlib format
+			// Original size not available in zlib and raw deflate format
 			// use an otherwise known size if supplied.
 			_origSize = knownSize;
 		}
@@ -194,7 +229,9 @@ public:
 		// the compressed file. This feature was added in zlib 1.2.0.4,
 		// released 10 August 2003.
 		// Note: This is *crucial* for savegame compatibility, do *not* remove!
-		_zlibErr = inflateInit2(&_stream, MAX_WBITS + 32);
+		// Negative windowBits indicate raw deflate data without any header.
+		_windowBits = isRawDeflate ? -MAX_WBITS : MAX_WBITS + 32;
+		_zlibErr = inflateInit2(&_stream, _windowBits);
 		if (_zlibErr != Z_OK)
 			return;
 
@@ -205,6 +242,9 @@ public:
 
 	~GZipReadStream() {
 		inflateEnd(&_stream);
+
+		for (uint i = 0; i < _accessPoints.size(); ++i)
+			free(_accessPoints[i].window);
 	}
 
 	bool err() const { return (_zlibErr != Z_OK) && (_zlibErr != Z_STREAM_END); }
@@ -224,6 +264,23 @@ public:
 				_stream.next_in = _buf;
 				_stream.avail_in = _wrapped->read(_buf, BUFSIZE);
 			}
+
+#ifdef USE_GZIP_ACCESS_POINTS
+			// Once the span since the last access point has been decompressed,
+			// stop at the next block boundary to add another one.
+			const uint32 outPos = _pos + dataSize - _stream.avail_out;
+			const uint32 lastAccessPoint = _accessPoints.empty() ? 0 : _accessPoints.back().outPos;
+			if (_maxAccessPoints > 0 && outPos >= lastAccessPoint + _accessPointSpan) {
+				_zlibErr = inflate(&_stream, Z_BLOCK);
+
+				// Bit 7 of data_type is set at the end of a block, bit 6 while
+				// the last block is decoded.
+				if (_zlibErr == Z_OK && (_stream.data_type & 128) && !(_stream.data_type & 64))
+					addAccessPoint(_pos + dataSize - _stream.avail_out);
+				continue;
+			}
+#endif
+
 			_zlibErr = inflate(&_stream, Z_NO_FLUSH);
 		}
 
@@ -262,6 +319,19 @@ public:
 
 		assert(newPos >= 0);
 
+#ifdef USE_GZIP_ACCESS_POINTS
+		// Continue from the last access point before the new position, if
+		// that saves decompressing data.
+		int accessPoint = (int)_accessPoints.size() - 1;
+		while (accessPoint >= 0 && _accessPoints[accessPoint].outPos > (uint32)newPos)
+			--accessPoint;
+
+		if (accessPoint >= 0 && ((uint32)newPos < _pos || _accessPoints[accessPoint].outPos > _pos)) {
+			if (!restoreAccessPoint(_accessPoints[accessPoint]))
+				return false;	// FIXME: STREAM REWRITE
+		}
+#endif
+
 		if ((uint32)newPos < _pos) {
 			// To search backward, we have to restart the whole decompression
 			// from the start of the file. A rather wasteful operation, best
@@ -279,7 +349,12 @@ public:
 
 			_pos = 0;
 			_wrapped->seek(0, SEEK_SET);
+#ifdef USE_GZIP_ACCESS_POINTS
+			// Restoring an access point switches to raw deflate data.
+			_zlibErr = inflateReset2(&_stream, _windowBits);
+#else
 			_zlibErr = inflateReset(&_stream);
+#endif
 			if (_zlibErr != Z_OK)
 				return false;	// FIXME: STREAM REWRITE
 			_stream.next_in = _buf;
@@ -299,6 +374,70 @@ public:
 		_eos = false;
 		return true;	// FIXME: STREAM REWRITE
 	}
+
+#ifdef USE_GZIP_ACCESS_POINTS
+private:
+	void addAccessPoint(uint32 outPos) {
+		if (_accessPoints.size() >= _maxAccessPoints) {
+			// Thin out the access points to stay within the memory limit.
+			uint kept = 0;
+			for (uint i = 0; i < _accessPoints.size(); ++i) {
+				if (i & 1)
+					free(_accessPoints[i].window);
+				else
+					_accessPoints[kept++] = _accessPoints[i];
+			}
+			_accessPoints.resize(kept);
+			_accessPointSpan *= 2;
+
+			if (_accessPoints.size() >= _maxAccessPoints || outPos < _accessPoints.back().outPos + _accessPointSpan)
+				return;
+		}
+
+		AccessPoint point;
+		point.outPos = outPos;
+		point.inPos = _wrapped->pos() - _stream.avail_in;
+		point.bits = _stream.data_type & 7;
+		point.window = (byte *)malloc(WINDOWSIZE);
+		if (!point.window)
+			return;
+
+		uInt windowSize = WINDOWSIZE;
+		if (inflateGetDictionary(&_stream, point.window, &windowSize) != Z_OK) {
+			free(point.window);
+			return;
+		}
+		point.windowSize = windowSize;
+
+		_accessPoints.push_back(point);
+	}
+
+	bool restoreAccessPoint(const AccessPoint &point) {
+		// The data after an access point is always raw deflate data, even
+		// if the stream has a gzip or zlib header.
+		_zlibErr = inflateReset2(&_stream, -MAX_WBITS);
+		if (_zlibErr != Z_OK)
+			return false;
+
+		_wrapped->seek(point.inPos - (point.bits ? 1 : 0), SEEK_SET);
+		if (point.bits) {
+			const byte partial = _wrapped->readByte();
+			_zlibErr = inflatePrime(&_stream, point.bits, partial >> (8 - point.bits));
+			if (_zlibErr != Z_OK)
+				return false;
+		}
+
+		_zlibErr = inflateSetDictionary(&_stream, point.window, point.windowSize);
+		if (_zlibErr != Z_OK)
+			return false;
+
+		_stream.next_in = _buf;
+		_stream.avail_in = 0;
+		_pos = point.outPos;
+		_eos = false;
+		return true;
+	}
+#endif
 };
 
 /**
@@ -413,7 +552,7 @@ public:
 
 #endif	// USE_ZLIB
 
-SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, uint32 knownSize) {
+SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, uint32 knownSize, uint32 accessPointMemory) {
 	if (toBeWrapped) {
 		uint16 header = toBeWrapped->readUint16BE();
 		bool isCompressed = (header == 0x1F8B ||
@@ -422,7 +561,7 @@ SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, ui
 		toBeWrapped->seek(-2, SEEK_CUR);
 		if (isCompressed) {
 #if defined(USE_ZLIB)
-			return new GZipReadStream(toBeWrapped, knownSize);
+			return new GZipReadStream(toBeWrapped, knownSize, false, accessPointMemory);
 #else
 			delete toBeWrapped;
 			return NULL;
@@ -432,6 +571,18 @@ SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, ui
 	return toBeWrapped;
 }
 
+SeekableReadStream *wrapDeflateReadStream(SeekableReadStream *toBeWrapped, uint32 knownSize, uint32 accessPointMemory) {
+	if (toBeWrapped) {
+#if defined(USE_ZLIB)
+		return new GZipReadStream(toBeWrapped, knownSize, true, accessPointMemory);
+#else
+		delete toBeWrapped;
+		return NULL;
+#endif
+	}
+	return NULL;
+}
+
 WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped) {
 #if defined(USE_ZLIB)
 	if (toBeWrapped)
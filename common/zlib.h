@@ -98,6 +98,14 @@ bool inflateZlibInstallShield(byte *dst, uint dstLen, const byte *src, uint srcL
 
 #endif
 
+enum {
+	/**
+	 * Default memory budget of a decompressing stream for the access points
+	 * it records to speed up seeking.
+	 */
+	kDefaultAccessPointMemory = 1024 * 1024
+};
+
 /**
  * Take an arbitrary SeekableReadStream and wrap it in a custom stream which
  * provides transparent on-the-fly decompression. Assumes the data it
@@ -116,10 +124,35 @@ bool inflateZlibInstallShield(byte *dst, uint dstLen, const byte *src, uint srcL
  * It is safe to call this with a NULL parameter (in this case, NULL is
  * returned).
  *
+ * While reading, the stream records access points from which decompression
+ * can be resumed when seeking. Each takes 32 KiB; once accessPointMemory is
+ * used up, the access points are spread further apart. A budget smaller
+ * than one access point disables them, and seeking backwards then has to
+ * decompress the stream again from the start.
+ *
  * @param toBeWrapped	the stream to be wrapped (if it is in gzip-format)
  * @param knownSize		a supplied length of the compressed data (if not available directly)
+ * @param accessPointMemory	the memory budget for the seek access points, in bytes
+ */
+SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, uint32 knownSize = 0, uint32 accessPointMemory = kDefaultAccessPointMemory);
+
+/**
+ * Take an arbitrary SeekableReadStream containing raw deflate data, i.e.
+ * without any gzip or zlib header, as used e.g. by ZIP archives, and wrap it
+ * in a custom stream which provides transparent on-the-fly decompression.
+ * If there is no ZLIB support, NULL is returned and the stream is destroyed.
+ * The created stream also becomes responsible for freeing the passed stream.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ *
+ * @param toBeWrapped	the stream to be wrapped
+ * @param knownSize		the size of the decompressed data
+ * @param accessPointMemory	the memory budget for the seek access points, in bytes
+ *
+ * @see wrapCompressedReadStream
  */
-SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, uint32 knownSize = 0);
+SeekableReadStream *wrapDeflateReadStream(SeekableReadStream *toBeWrapped, uint32 knownSize, uint32 accessPointMemory = kDefaultAccessPointMemory);
 
 /**
  * Take an arbitrary WriteStream and wrap it in a custom stream which provides
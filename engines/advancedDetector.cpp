@@ -390,28 +390,42 @@ bool AdvancedMetaEngine::getFileProperties(const Common::FSNode &parent, const F
 	// file and as one with resource fork.
 
 	if (game.flags & ADGF_MACRESFORK) {
-		Common::MacResManager macResMan;
+		Common::String resForkPath = parent.getPath() + "/" + fname;
 
-		if (!macResMan.open(parent, fname))
-			return false;
+		if (ADFilePropsCache.lookup(resForkPath, _md5Bytes, true, fileProps)) {
+			if (fileProps.size != 0)
+				return true;
+		} else {
+			Common::MacResManager macResMan;
 
-		fileProps.md5 = macResMan.computeResForkMD5AsString(_md5Bytes);
-		fileProps.size = macResMan.getResForkDataSize();
+			if (!macResMan.open(parent, fname))
+				return false;
 
-		if (fileProps.size != 0)
-			return true;
+			fileProps.md5 = macResMan.computeResForkMD5AsString(_md5Bytes);
+			fileProps.size = macResMan.getResForkDataSize();
+			ADFilePropsCache.store(resForkPath, _md5Bytes, true, fileProps);
+
+			if (fileProps.size != 0)
+				return true;
+		}
 	}
 
 	if (!allFiles.contains(fname))
 		return false;
 
+	const Common::FSNode &node = allFiles[fname];
+
+	if (ADFilePropsCache.lookup(node.getPath(), _md5Bytes, false, fileProps))
+		return true;
+
 	Common::File testFile;
 
-	if (!testFile.open(allFiles[fname]))
+	if (!testFile.open(node))
 		return false;
 
 	fileProps.size = (int32)testFile.size();
 	fileProps.md5 = Common::computeStreamMD5AsString(testFile, _md5Bytes);
+	ADFilePropsCache.store(node.getPath(), _md5Bytes, false, fileProps);
 	return true;
 }
 
@@ -635,3 +649,52 @@ void AdvancedMetaEngine::initSubSystems(const ADGameDescription *gameDesc) const
 	}
 #endif
 }
+
+namespace Common {
+DECLARE_SINGLETON(ADFilePropertiesCache);
+}
+
+ADFilePropertiesCache::ADFilePropertiesCache() : _scanDepth(0), _hits(0), _misses(0) {
+}
+
+void ADFilePropertiesCache::beginScan() {
+	if (_scanDepth++ == 0) {
+		_hits = 0;
+		_misses = 0;
+	}
+}
+
+void ADFilePropertiesCache::endScan() {
+	assert(_scanDepth > 0);
+
+	if (--_scanDepth == 0) {
+		debug(3, "Detection file cache: %u hits, %u misses", _hits, _misses);
+		_cache.clear();
+	}
+}
+
+Common::String ADFilePropertiesCache::makeKey(const Common::String &path, uint md5Bytes, bool resFork) {
+	return Common::String::format("%c%u:%s", resFork ? 'r' : 'd', md5Bytes, path.c_str());
+}
+
+bool ADFilePropertiesCache::lookup(const Common::String &path, uint md5Bytes, bool resFork, ADFileProperties &fileProps) {
+	if (_scanDepth == 0)
+		return false;
+
+	PropertiesMap::const_iterator i = _cache.find(makeKey(path, md5Bytes, resFork));
+	if (i == _cache.end()) {
+		_misses++;
+		return false;
+	}
+
+	_hits++;
+	fileProps = i->_value;
+	return true;
+}
+
+void ADFilePropertiesCache::store(const Common::String &path, uint md5Bytes, bool resFork, const ADFileProperties &fileProps) {
+	if (_scanDepth == 0)
+		return;
+
+	_cache[makeKey(path, md5Bytes, resFork)] = fileProps;
+}
@@ -27,6 +27,7 @@
 #include "engines/engine.h"
 
 #include "common/hash-str.h"
+#include "common/singleton.h"
 
 #include "common/gui_options.h" // FIXME: Temporary hack?
 
@@ -61,6 +62,57 @@ struct ADFileProperties {
  */
 typedef Common::HashMap<Common::String, ADFileProperties, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> ADFilePropertiesMap;
 
+/**
+ * Singleton class which remembers the properties of files inspected while
+ * detecting games. Most engines look at the same few files in a directory,
+ * so sharing the results between all AdvancedMetaEngine instances saves
+ * reading and hashing them over and over again.
+ *
+ * The cache is only active between a call to beginScan() and the matching
+ * call to endScan(); outside of a scan nothing is stored, so that files
+ * changed on disk between two detection runs are never reported stale.
+ */
+class ADFilePropertiesCache : public Common::Singleton<ADFilePropertiesCache> {
+public:
+	ADFilePropertiesCache();
+
+	/** Start a detection run. Calls may be nested. */
+	void beginScan();
+
+	/** End a detection run. The cache is flushed once the outermost run ends. */
+	void endScan();
+
+	/**
+	 * Look up the properties of a file.
+	 *
+	 * @param path		full path of the file
+	 * @param md5Bytes	number of bytes the MD5 was computed over
+	 * @param resFork	whether the properties are those of the resource fork
+	 * @param fileProps	receives the cached properties
+	 * @return true if the properties were found in the cache
+	 */
+	bool lookup(const Common::String &path, uint md5Bytes, bool resFork, ADFileProperties &fileProps);
+
+	/** Store the properties of a file, if a detection run is active. */
+	void store(const Common::String &path, uint md5Bytes, bool resFork, const ADFileProperties &fileProps);
+
+	uint getHits() const { return _hits; }
+	uint getMisses() const { return _misses; }
+
+private:
+	static Common::String makeKey(const Common::String &path, uint md5Bytes, bool resFork);
+
+	typedef Common::HashMap<Common::String, ADFileProperties> PropertiesMap;
+
+	PropertiesMap _cache;
+	int _scanDepth;
+	uint _hits;
+	uint _misses;
+};
+
+/** Convenience shortcut for accessing the detection file properties cache. */
+#define ADFilePropsCache ADFilePropertiesCache::instance()
+
 /**
  * A shortcut to produce an empty ADGameFileDescription record. Used to mark
  * the end of a list of these.
@@ -36,6 +36,7 @@
 #include "common/config-manager.h"
 #include "common/events.h"
 #include "common/file.h"
+#include "common/fs.h"
 #include "common/system.h"
 #include "common/str.h"
 #include "common/error.h"
@@ -191,7 +192,14 @@ Engine::~Engine() {
 }
 
 void Engine::initializePath(const Common::FSNode &gamePath) {
-	SearchMan.addDirectory(gamePath.getPath(), gamePath, 0, 4);
+	if (!gamePath.exists() || !gamePath.isDirectory())
+		return;
+
+	// The game data is never modified while the game runs, so large files
+	// may be mapped into memory instead of being read.
+	Common::FSDirectory *dir = new Common::FSDirectory(gamePath, 4);
+	dir->setMapFiles(true);
+	SearchMan.add(gamePath.getPath(), dir, 0);
 }
 
 void initCommonGFX(bool defaultTo1XScaler) {
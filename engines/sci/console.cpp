@@ -53,6 +53,7 @@
 #include "video/avi_decoder.h"
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
+#include "sci/graphics/celobj32.h"
 #include "sci/graphics/frameout.h"
 #include "sci/graphics/paint32.h"
 #include "sci/graphics/palette32.h"
@@ -74,7 +75,8 @@ bool g_debug_track_mouse_clicks = false;
 static int parse_reg_t(EngineState *s, const char *str, reg_t *dest, bool mayBeValue);
 
 Console::Console(SciEngine *engine) : GUI::Debugger(),
-	_engine(engine), _debugState(engine->_debugState) {
+	_engine(engine), _debugState(engine->_debugState),
+	_lastSendCounter(0), _lastSendCounterTime(0) {
 
 	assert(_engine);
 	assert(_engine->_gamestate);
@@ -96,6 +98,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("opcodes",			WRAP_METHOD(Console, cmdOpcodes));
 	registerCmd("selector",			WRAP_METHOD(Console, cmdSelector));
 	registerCmd("selectors",			WRAP_METHOD(Console, cmdSelectors));
+	registerCmd("selector_cache",		WRAP_METHOD(Console, cmdSelectorCache));
 	registerCmd("functions",			WRAP_METHOD(Console, cmdKernelFunctions));
 	registerCmd("class_table",		WRAP_METHOD(Console, cmdClassTable));
 	// Parser
@@ -147,6 +150,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("vpi",                WRAP_METHOD(Console, cmdVisiblePlaneItemList));	// alias
 	registerCmd("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	registerCmd("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
+	registerCmd("cel_cache",          WRAP_METHOD(Console, cmdCelCache));
 	// Segments
 	registerCmd("segment_table",		WRAP_METHOD(Console, cmdPrintSegmentTable));
 	registerCmd("segtable",			WRAP_METHOD(Console, cmdPrintSegmentTable));	// alias
@@ -156,6 +160,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("segkill",			WRAP_METHOD(Console, cmdKillSegment));			// alias
 	// Garbage collection
 	registerCmd("gc",					WRAP_METHOD(Console, cmdGCInvoke));
+	registerCmd("gc_stats",			WRAP_METHOD(Console, cmdGCStats));
 	registerCmd("gc_objects",			WRAP_METHOD(Console, cmdGCObjects));
 	registerCmd("gc_reachable",		WRAP_METHOD(Console, cmdGCShowReachable));
 	registerCmd("gc_freeable",		WRAP_METHOD(Console, cmdGCShowFreeable));
@@ -350,6 +355,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" opcodes - Lists the opcode names\n");
 	debugPrintf(" selectors - Lists the selector names\n");
 	debugPrintf(" selector - Attempts to find the requested selector by name\n");
+	debugPrintf(" selector_cache - Shows statistics of the selector lookup cache\n");
 	debugPrintf(" functions - Lists the kernel functions\n");
 	debugPrintf(" class_table - Shows the available classes\n");
 	debugPrintf("\n");
@@ -399,6 +405,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
 	debugPrintf(" show_saved_bits - Display saved bits\n");
+	debugPrintf(" cel_cache - Shows statistics of the cel cache, or sets its size (SCI2+)\n");
 	debugPrintf("\n");
 	debugPrintf("Segments:\n");
 	debugPrintf(" segment_table / segtable - Lists all segments\n");
@@ -407,6 +414,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("Garbage collection:\n");
 	debugPrintf(" gc - Invokes the garbage collector\n");
+	debugPrintf(" gc_stats - Shows pause times and freed objects of the garbage collections\n");
 	debugPrintf(" gc_objects - Lists all reachable objects, normalized\n");
 	debugPrintf(" gc_reachable - Lists all addresses directly reachable from a given memory object\n");
 	debugPrintf(" gc_freeable - Lists all addresses freeable in a given segment\n");
@@ -574,6 +582,32 @@ bool Console::cmdSelector(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdSelectorCache(int argc, const char **argv) {
+	uint32 hits, misses, flushes;
+	uint entries;
+	_engine->_gamestate->_segMan->getSelectorCacheStats(hits, misses, flushes, entries);
+
+	debugPrintf("Selector lookup cache: %u entries, flushed %u times\n", entries, flushes);
+	debugPrintf("Lookups: %u hits, %u misses", hits, misses);
+	if (hits + misses)
+		debugPrintf(" (%u%% hit rate)", (uint32)((uint64)hits * 100 / (hits + misses)));
+	debugPrintf("\n");
+
+	// The send rate is measured since the previous invocation
+	const uint32 sendCounter = _engine->_gamestate->scriptSendCounter;
+	const uint32 time = g_system->getMillis();
+	if (_lastSendCounterTime && time > _lastSendCounterTime) {
+		debugPrintf("Sends: %u, %u per second since the last invocation\n", sendCounter,
+		            (uint32)((uint64)(sendCounter - _lastSendCounter) * 1000 / (time - _lastSendCounterTime)));
+	} else {
+		debugPrintf("Sends: %u\n", sendCounter);
+	}
+	_lastSendCounter = sendCounter;
+	_lastSendCounterTime = time;
+
+	return true;
+}
+
 bool Console::cmdSelectors(int argc, const char **argv) {
 	debugPrintf("Selector names in numeric order:\n");
 	Common::String selectorName;
@@ -1861,6 +1895,39 @@ bool Console::cmdVisiblePlaneList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdCelCache(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	CelCache *cache = CelObj::getCache();
+	if (!cache) {
+		debugPrintf("This SCI version does not have a cel cache\n");
+		return true;
+	}
+
+	if (argc > 2) {
+		debugPrintf("Shows statistics of the cel cache, or sets its maximum size\n");
+		debugPrintf("Usage: %s [<size in KB>]\n", argv[0]);
+		return true;
+	}
+
+	if (argc == 2) {
+		cache->setMaxSize(strtoul(argv[1], nullptr, 10) * 1024);
+	}
+
+	const uint32 hits = cache->getHits();
+	const uint32 misses = cache->getMisses();
+
+	debugPrintf("Cel cache: %u cels, %u of %u KB used\n", cache->getNumEntries(), cache->getSize() / 1024, cache->getMaxSize() / 1024);
+	debugPrintf("Lookups: %u hits, %u misses", hits, misses);
+	if (hits + misses) {
+		debugPrintf(" (%u%% hit rate)", (uint32)((uint64)hits * 100 / (hits + misses)));
+	}
+	debugPrintf(", %u cels evicted\n", cache->getEvictions());
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 
 bool Console::cmdPlaneItemList(int argc, const char **argv) {
 	if (argc != 2) {
@@ -2498,6 +2565,21 @@ bool Console::cmdGCInvoke(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdGCStats(int argc, const char **argv) {
+	const GCStatistics &stats = _engine->_gamestate->gcStats;
+
+	debugPrintf("Garbage collections: %u, every %d kernel calls\n", stats.runs, _engine->_gamestate->scriptGCInterval);
+	if (!stats.runs)
+		return true;
+
+	debugPrintf("Pause times: last %u ms (mark %u ms, sweep %u ms), max %u ms, average %u ms, total %u ms\n",
+	            stats.lastMarkTime + stats.lastSweepTime, stats.lastMarkTime, stats.lastSweepTime,
+	            stats.maxPauseTime, stats.totalPauseTime / stats.runs, stats.totalPauseTime);
+	debugPrintf("Last run: %u active references, %u objects freed\n", stats.lastReachable, stats.lastFreed);
+	debugPrintf("Objects freed in total: %u\n", stats.totalFreed);
+	return true;
+}
+
 bool Console::cmdGCObjects(int argc, const char **argv) {
 	AddrSet *use_map = findAllActiveReferences(_engine->_gamestate);
 
@@ -22,6 +22,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 #ifdef ENABLE_SCI32
@@ -84,6 +85,31 @@ static AddrSet *normalizeAddresses(SegManager *segMan, const AddrSet &nonnormal_
 	return normal_map;
 }
 
+/**
+ * Adds the canonic address of every reference, which is not canonic itself,
+ * to the set. This is cheaper than normalizing a copy of the whole set, since
+ * only references into scripts, locals, the stack and dynamic memory are
+ * affected. The deallocatable addresses of these segments are all canonic,
+ * so the extended set gives the same answers for them as a normalized one.
+ */
+static void addCanonicAddresses(SegManager *segMan, AddrSet &map) {
+	Common::Array<reg_t> canonic;
+
+	for (AddrSet::const_iterator i = map.begin(); i != map.end(); ++i) {
+		const reg_t reg = i->_key;
+		SegmentObj *mobj = segMan->getSegmentObj(reg.getSegment());
+
+		if (mobj) {
+			const reg_t canonicReg = mobj->findCanonicAddress(segMan, reg);
+			if (canonicReg != reg)
+				canonic.push_back(canonicReg);
+		}
+	}
+
+	for (Common::Array<reg_t>::const_iterator it = canonic.begin(); it != canonic.end(); ++it)
+		map.setVal(*it, true);
+}
+
 static void processWorkList(SegManager *segMan, WorklistManager &wm, const Common::Array<SegmentObj *> &heap) {
 	SegmentId stackSegment = segMan->findSegmentByType(SEG_TYPE_STACK);
 	while (!wm._worklist.empty()) {
@@ -99,11 +125,9 @@ static void processWorkList(SegManager *segMan, WorklistManager &wm, const Commo
 	}
 }
 
-AddrSet *findAllActiveReferences(EngineState *s) {
+static void markActiveReferences(EngineState *s, WorklistManager &wm) {
 	assert(!s->_executionStack.empty());
 
-	WorklistManager wm;
-
 	// Initialize registers
 	wm.push(s->r_acc);
 	wm.push(s->r_prev);
@@ -175,7 +199,11 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 
 	if (g_sci->_gfxPorts)
 		g_sci->_gfxPorts->processEngineHunkList(wm);
+}
 
+AddrSet *findAllActiveReferences(EngineState *s) {
+	WorklistManager wm;
+	markActiveReferences(s, wm);
 	return normalizeAddresses(s->_segMan, wm._map);
 }
 
@@ -191,8 +219,17 @@ void run_gc(EngineState *s) {
 	memset(segcount, 0, sizeof(segcount));
 #endif
 
+	GCStatistics &stats = s->gcStats;
+	const uint32 startTime = g_system->getMillis();
+	uint freed = 0;
+
 	// Compute the set of all segments references currently in use.
-	AddrSet *activeRefs = findAllActiveReferences(s);
+	WorklistManager wm;
+	markActiveReferences(s, wm);
+	addCanonicAddresses(segMan, wm._map);
+	const AddrSet &activeRefs = wm._map;
+
+	const uint32 sweepTime = g_system->getMillis();
 
 	// Iterate over all segments, and check for each whether it
 	// contains stuff that can be collected.
@@ -211,9 +248,10 @@ void run_gc(EngineState *s) {
 			const Common::Array<reg_t> tmp = mobj->listAllDeallocatable(seg);
 			for (Common::Array<reg_t>::const_iterator it = tmp.begin(); it != tmp.end(); ++it) {
 				const reg_t addr = *it;
-				if (!activeRefs->contains(addr)) {
+				if (!activeRefs.contains(addr)) {
 					// Not found -> we can free it
 					mobj->freeAtAddress(segMan, addr);
+					freed++;
 					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
@@ -224,7 +262,15 @@ void run_gc(EngineState *s) {
 		}
 	}
 
-	delete activeRefs;
+	const uint32 endTime = g_system->getMillis();
+	stats.runs++;
+	stats.lastMarkTime = sweepTime - startTime;
+	stats.lastSweepTime = endTime - sweepTime;
+	stats.totalPauseTime += endTime - startTime;
+	stats.maxPauseTime = MAX(stats.maxPauseTime, endTime - startTime);
+	stats.lastReachable = activeRefs.size();
+	stats.lastFreed = freed;
+	stats.totalFreed += freed;
 
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
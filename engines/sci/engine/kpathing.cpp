@@ -111,10 +111,14 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// Index in the visibility graph, or -1 if the vertex has no edges
+	int graph_index;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = NULL;
+		graph_index = -1;
 	}
 };
 
@@ -250,6 +254,12 @@ struct PathfindingState {
 	// Total number of vertices
 	int vertices;
 
+	// Vertices of all polygons with edges, indexed by Vertex::graph_index
+	Common::Array<Vertex *> edge_vertices;
+
+	// Visibility graph of the polygon set, owned by the cache in EngineState
+	VisibilityGraph *visibility;
+
 	// Point to prepend and append to final path
 	Common::Point *_prependPoint;
 	Common::Point *_appendPoint;
@@ -264,6 +274,7 @@ struct PathfindingState {
 		_prependPoint = NULL;
 		_appendPoint = NULL;
 		vertices = 0;
+		visibility = NULL;
 	}
 
 	~PathfindingState() {
@@ -659,6 +670,260 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+enum {
+	// Size of the cells of the edge grid, as a power of two
+	kEdgeGridCellShift = 4,
+
+	// Number of polygon sets for which the visibility graph is kept
+	kVisibilityGraphCacheSize = 4
+};
+
+enum VisibilityState {
+	kVisibilityUnknown = 0,
+	kVisibilityVisible = 1,
+	kVisibilityHidden = 2
+};
+
+/**
+ * Visibility information of a polygon set, which is kept across kAvoidPath
+ * calls for as long as the polygons don't change. The visibility between
+ * two vertices with edges only depends on the edges, so it is computed once
+ * on demand and stored here. Vertices without edges, usually the start and
+ * end points, are checked against the edge grid on every call instead.
+ */
+struct VisibilityGraph {
+	// The vertices of all polygons with edges, and the number of vertices
+	// of each of these polygons. Identifies the polygon set.
+	Common::Array<Common::Point> points;
+	Common::Array<uint> polygonSizes;
+
+	// Visibility between each pair of vertices, a VisibilityState
+	Common::Array<byte> states;
+
+	// Grid over the edges. Each cell lists the edges (by the index of their
+	// first vertex) whose bounding box overlaps the cell.
+	int gridLeft, gridTop;
+	int gridColumns, gridRows;
+	Common::Array<Common::Array<uint16> > gridCells;
+
+	// Marks the edges already tested for the current line
+	Common::Array<uint32> edgeStamps;
+	uint32 stamp;
+
+	VisibilityGraph(const Common::Array<Vertex *> &edgeVertices, const Common::Array<uint> &sizes);
+
+	/**
+	 * Determines whether the line (a, b) is blocked by any edge.
+	 * @param edgeVertices	the vertices of the polygon set, by graph index
+	 * @param a, b			the line
+	 * @return true if an edge blocks the line, false otherwise
+	 */
+	bool isLineBlocked(const Common::Array<Vertex *> &edgeVertices, const Common::Point &a, const Common::Point &b);
+};
+
+VisibilityGraph::VisibilityGraph(const Common::Array<Vertex *> &edgeVertices, const Common::Array<uint> &sizes) :
+	polygonSizes(sizes), stamp(0) {
+	const uint count = edgeVertices.size();
+
+	points.resize(count);
+	states.resize(count * count);
+	edgeStamps.resize(count);
+
+	int right = 0, bottom = 0;
+	gridLeft = gridTop = 0;
+	for (uint i = 0; i < count; i++) {
+		const Common::Point &p = edgeVertices[i]->v;
+		points[i] = p;
+		states[i * count + i] = kVisibilityHidden;
+		edgeStamps[i] = 0;
+
+		if (i == 0 || p.x < gridLeft)
+			gridLeft = p.x;
+		if (i == 0 || p.y < gridTop)
+			gridTop = p.y;
+		if (i == 0 || p.x > right)
+			right = p.x;
+		if (i == 0 || p.y > bottom)
+			bottom = p.y;
+	}
+
+	gridColumns = ((right - gridLeft) >> kEdgeGridCellShift) + 1;
+	gridRows = ((bottom - gridTop) >> kEdgeGridCellShift) + 1;
+	gridCells.resize(gridColumns * gridRows);
+
+	for (uint i = 0; i < count; i++) {
+		const Common::Point &p = edgeVertices[i]->v;
+		const Common::Point &q = CLIST_NEXT(edgeVertices[i])->v;
+		const int firstColumn = (MIN(p.x, q.x) - gridLeft) >> kEdgeGridCellShift;
+		const int lastColumn = (MAX(p.x, q.x) - gridLeft) >> kEdgeGridCellShift;
+		const int firstRow = (MIN(p.y, q.y) - gridTop) >> kEdgeGridCellShift;
+		const int lastRow = (MAX(p.y, q.y) - gridTop) >> kEdgeGridCellShift;
+
+		for (int row = firstRow; row <= lastRow; row++) {
+			for (int column = firstColumn; column <= lastColumn; column++)
+				gridCells[row * gridColumns + column].push_back(i);
+		}
+	}
+}
+
+/**
+ * Determines whether an edge blocks the line (a, b)
+ * Parameters: (const Common::Point &) a, b: The line
+ *             (Vertex *) edge: The edge, from this vertex to the next one
+ * Returns   : (bool) true if the edge blocks the line, false otherwise
+ */
+static bool edgeBlocksLine(const Common::Point &a, const Common::Point &b, Vertex *edge) {
+	if (between(a, b, edge->v)) {
+		// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+		return inside(a, edge) || inside(b, edge);
+	}
+
+	return intersect_proper(a, b, edge->v, CLIST_NEXT(edge)->v);
+}
+
+bool VisibilityGraph::isLineBlocked(const Common::Array<Vertex *> &edgeVertices, const Common::Point &a, const Common::Point &b) {
+	const int cellSize = 1 << kEdgeGridCellShift;
+
+	// between() treats every vertex on the same row as lying on a line of
+	// length zero, so such lines have to be checked against all edges
+	if (a == b) {
+		for (uint i = 0; i < edgeVertices.size(); i++) {
+			if (edgeBlocksLine(a, b, edgeVertices[i]))
+				return true;
+		}
+		return false;
+	}
+
+	// Coordinates relative to the grid, from top to bottom
+	int x0 = a.x - gridLeft, y0 = a.y - gridTop;
+	int x1 = b.x - gridLeft, y1 = b.y - gridTop;
+	if (y0 > y1) {
+		SWAP(x0, x1);
+		SWAP(y0, y1);
+	}
+
+	if (y1 < 0 || y0 >= gridRows * cellSize)
+		return false;
+
+	if (++stamp == 0) {
+		for (uint i = 0; i < edgeStamps.size(); i++)
+			edgeStamps[i] = 0;
+		stamp = 1;
+	}
+
+	const int firstRow = MAX(y0, 0) >> kEdgeGridCellShift;
+	const int lastRow = MIN(y1, gridRows * cellSize - 1) >> kEdgeGridCellShift;
+
+	for (int row = firstRow; row <= lastRow; row++) {
+		// Horizontal extent of the line within this row. The division
+		// is off by less than a pixel, which is covered by the margin.
+		const int top = MAX(y0, row * cellSize);
+		const int bottom = MIN(y1, (row + 1) * cellSize);
+		int left = x0, right = x1;
+		if (y0 != y1) {
+			left = x0 + (int)((int64)(x1 - x0) * (top - y0) / (y1 - y0));
+			right = x0 + (int)((int64)(x1 - x0) * (bottom - y0) / (y1 - y0));
+		}
+		if (left > right)
+			SWAP(left, right);
+		left = MAX(left - 1, 0);
+		right = MIN(right + 1, gridColumns * cellSize - 1);
+
+		for (int column = left >> kEdgeGridCellShift; column <= (right >> kEdgeGridCellShift); column++) {
+			const Common::Array<uint16> &cell = gridCells[row * gridColumns + column];
+
+			for (uint i = 0; i < cell.size(); i++) {
+				const uint16 edge = cell[i];
+				if (edgeStamps[edge] == stamp)
+					continue;
+
+				edgeStamps[edge] = stamp;
+				if (edgeBlocksLine(a, b, edgeVertices[edge]))
+					return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void freeVisibilityGraphs(Common::List<VisibilityGraph *> &graphs) {
+	for (Common::List<VisibilityGraph *>::iterator it = graphs.begin(); it != graphs.end(); ++it)
+		delete *it;
+	graphs.clear();
+}
+
+/**
+ * Looks up the visibility graph of the polygon set in the cache, or creates
+ * it, and assigns the graph indices of the vertices
+ * Parameters: (EngineState *) s: The game state
+ *             (PathfindingState *) p: The pathfinding state
+ */
+static void attach_visibility_graph(EngineState *s, PathfindingState *p) {
+	Common::Array<uint> sizes;
+	Common::Array<Vertex *> &edgeVertices = p->edge_vertices;
+
+	for (PolygonList::iterator it = p->polygons.begin(); it != p->polygons.end(); ++it) {
+		Polygon *polygon = *it;
+		Vertex *vertex;
+
+		if (!VERTEX_HAS_EDGES(polygon->vertices.first()))
+			continue;
+
+		const uint first = edgeVertices.size();
+		CLIST_FOREACH(vertex, &polygon->vertices) {
+			vertex->graph_index = edgeVertices.size();
+			edgeVertices.push_back(vertex);
+		}
+		sizes.push_back(edgeVertices.size() - first);
+	}
+
+	Common::List<VisibilityGraph *> &cache = s->_visibilityGraphs;
+	for (Common::List<VisibilityGraph *>::iterator it = cache.begin(); it != cache.end(); ++it) {
+		VisibilityGraph *graph = *it;
+
+		if (graph->polygonSizes != sizes || graph->points.size() != edgeVertices.size())
+			continue;
+
+		uint i;
+		for (i = 0; i < edgeVertices.size(); i++) {
+			if (graph->points[i] != edgeVertices[i]->v)
+				break;
+		}
+
+		if (i == edgeVertices.size()) {
+			debugC(kDebugLevelAvoidPath, "AvoidPath: Reusing visibility graph of %u vertices", edgeVertices.size());
+			cache.erase(it);
+			cache.push_front(graph);
+			p->visibility = graph;
+			return;
+		}
+	}
+
+	if (cache.size() >= kVisibilityGraphCacheSize) {
+		delete cache.back();
+		cache.pop_back();
+	}
+
+	p->visibility = new VisibilityGraph(edgeVertices, sizes);
+	cache.push_front(p->visibility);
+}
+
+/**
+ * Determines whether two vertices can see each other
+ * Parameters: (PathfindingState *) s: The pathfinding state
+ *             (Vertex *) vertex_cur, vertex: The vertices
+ * Returns   : (bool) true if the vertices are visible, false otherwise
+ */
+static bool is_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		return false;
+
+	// Check for intersecting edges
+	return !s->visibility->isLineBlocked(s->edge_vertices, vertex_cur->v, vertex->v);
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
  * @param s				the pathfinding state
@@ -667,34 +932,30 @@ static int inside(const Common::Point &p, Vertex *vertex) {
  */
 static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 	VertexList *visVerts = new VertexList();
+	const uint count = s->edge_vertices.size();
 
 	for (int i = 0; i < s->vertices; i++) {
 		Vertex *vertex = s->vertex_index[i];
 
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		if (vertex == vertex_cur)
 			continue;
 
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
+		bool visible;
+		if (vertex_cur->graph_index >= 0 && vertex->graph_index >= 0) {
+			// Visibility is symmetric, so it's stored for both directions
+			byte &state = s->visibility->states[vertex_cur->graph_index * count + vertex->graph_index];
 
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
+			if (state == kVisibilityUnknown) {
+				state = is_visible(s, vertex_cur, vertex) ? kVisibilityVisible : kVisibilityHidden;
+				s->visibility->states[vertex->graph_index * count + vertex_cur->graph_index] = state;
 			}
+
+			visible = (state == kVisibilityVisible);
+		} else {
+			visible = is_visible(s, vertex_cur, vertex);
 		}
 
-		if (j == s->vertices)
+		if (visible)
 			visVerts->push_front(vertex);
 	}
 
@@ -1299,6 +1560,8 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 
 	pf_s->vertices = count;
 
+	attach_visibility_graph(s, pf_s);
+
 	return pf_s;
 }
 
@@ -29,6 +29,8 @@
 #include "sci/engine/kernel.h"
 #include "sci/engine/script.h"
 
+#include "common/algorithm.h"
+#include "common/hashmap.h"
 #include "common/util.h"
 
 namespace Sci {
@@ -73,6 +75,10 @@ void Script::freeScript(const bool keepLocalsSegment) {
 	_offsetLookupObjectCount = 0;
 	_offsetLookupStringCount = 0;
 	_offsetLookupSaidCount = 0;
+
+	_decodedInstructions.clear();
+	_decodedInstructionIndex.clear();
+	_lastDecodedInstruction = kNoDecodedInstruction;
 }
 
 enum {
@@ -1282,4 +1288,143 @@ bool Script::offsetIsObject(uint32 offset) const {
 	return _buf->getUint16SEAt(offset + SCRIPT_OBJECT_MAGIC_OFFSET) == SCRIPT_OBJECT_MAGIC_NUMBER;
 }
 
+enum {
+	/** Size of an instruction with three 16-bit operands */
+	kMaxInstructionSize = 7
+};
+
+/** Orders slots of decoded instructions by the offset of the instruction. */
+struct DecodedInstructionOffsetLess {
+	const Common::Array<DecodedInstruction> &_instructions;
+
+	DecodedInstructionOffsetLess(const Common::Array<DecodedInstruction> &instructions) : _instructions(instructions) {}
+
+	bool operator()(uint16 a, uint16 b) const {
+		return _instructions[a].offset < _instructions[b].offset;
+	}
+};
+
+static bool isBranchOrCall(byte opcode) {
+	return opcode == op_bt || opcode == op_bnt || opcode == op_jmp || opcode == op_call;
+}
+
+int Script::readInstruction(uint32 offset, byte &extOpcode, int16 opparams[4]) {
+	// Usually, the instruction follows the last one read or is its branch
+	// target, so the index only needs to be searched after calls and sends.
+	uint16 slot = kNoDecodedInstruction;
+	if (_lastDecodedInstruction != kNoDecodedInstruction) {
+		const DecodedInstruction &last = _decodedInstructions[_lastDecodedInstruction];
+		if (last.next != kNoDecodedInstruction && _decodedInstructions[last.next].offset == offset)
+			slot = last.next;
+		else if (last.target != kNoDecodedInstruction && _decodedInstructions[last.target].offset == offset)
+			slot = last.target;
+	}
+
+	if (slot == kNoDecodedInstruction) {
+		slot = findDecodedInstruction(offset);
+		if (slot == kNoDecodedInstruction && canDecodeInstruction(offset)) {
+			decodeInstructions(offset);
+			slot = findDecodedInstruction(offset);
+		}
+	}
+
+	_lastDecodedInstruction = slot;
+	if (slot == kNoDecodedInstruction)
+		return readPMachineInstruction(getBuf(offset), extOpcode, opparams);
+
+	const DecodedInstruction &instruction = _decodedInstructions[slot];
+	extOpcode = instruction.extOpcode;
+	opparams[0] = instruction.opparams[0];
+	opparams[1] = instruction.opparams[1];
+	opparams[2] = instruction.opparams[2];
+	opparams[3] = 0;
+	return instruction.size;
+}
+
+uint16 Script::findDecodedInstruction(uint32 offset) const {
+	uint low = 0;
+	uint high = _decodedInstructionIndex.size();
+	while (low < high) {
+		const uint middle = (low + high) / 2;
+		if (_decodedInstructions[_decodedInstructionIndex[middle]].offset < offset)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	if (low < _decodedInstructionIndex.size() && _decodedInstructions[_decodedInstructionIndex[low]].offset == offset)
+		return _decodedInstructionIndex[low];
+	return kNoDecodedInstruction;
+}
+
+bool Script::canDecodeInstruction(uint32 offset) const {
+	// The code is always in the script part of the buffer, not in the heap.
+	// Branches in code which never runs may lead anywhere, though.
+	if (offset >= getScriptSize() || offset + kMaxInstructionSize > getBufSize())
+		return false;
+
+	const byte extOpcode = *getBuf(offset);
+	const byte opcode = extOpcode >> 1;
+
+	// Invalid opcodes are left to the VM to report
+	if (g_sci->_opcode_formats[opcode][0] == Script_Invalid)
+		return false;
+
+	// The debug opcode op_file shares its opcode with op_pushSelf and is
+	// followed by a file name of any length
+	if (opcode == op_pushSelf && (extOpcode & 1))
+		return false;
+
+	return true;
+}
+
+void Script::decodeInstructions(uint32 offset) {
+	const uint firstSlot = _decodedInstructions.size();
+	Common::HashMap<uint32, bool> decodedOffsets;
+	Common::Array<uint32> pending;
+	pending.push_back(offset);
+
+	while (!pending.empty()) {
+		offset = pending.back();
+		pending.pop_back();
+
+		while (_decodedInstructions.size() < kNoDecodedInstruction && canDecodeInstruction(offset) &&
+		       !decodedOffsets.contains(offset) && findDecodedInstruction(offset) == kNoDecodedInstruction) {
+			DecodedInstruction instruction;
+			int16 opparams[4];
+			instruction.offset = offset;
+			instruction.size = readPMachineInstruction(getBuf(offset), instruction.extOpcode, opparams);
+			instruction.next = kNoDecodedInstruction;
+			instruction.target = kNoDecodedInstruction;
+			instruction.opparams[0] = opparams[0];
+			instruction.opparams[1] = opparams[1];
+			instruction.opparams[2] = opparams[2];
+
+			decodedOffsets[offset] = true;
+			_decodedInstructions.push_back(instruction);
+
+			// Branch offsets are relative to the following instruction
+			const byte opcode = instruction.extOpcode >> 1;
+			offset += instruction.size;
+			if (isBranchOrCall(opcode))
+				pending.push_back(offset + opparams[0]);
+			if (opcode == op_jmp || opcode == op_ret)
+				break;
+		}
+	}
+
+	for (uint slot = firstSlot; slot < _decodedInstructions.size(); ++slot)
+		_decodedInstructionIndex.push_back(slot);
+	Common::sort(_decodedInstructionIndex.begin(), _decodedInstructionIndex.end(), DecodedInstructionOffsetLess(_decodedInstructions));
+
+	// Link the new instructions to the instructions which may follow them
+	for (uint slot = firstSlot; slot < _decodedInstructions.size(); ++slot) {
+		DecodedInstruction &instruction = _decodedInstructions[slot];
+		const uint32 nextOffset = instruction.offset + instruction.size;
+		instruction.next = findDecodedInstruction(nextOffset);
+		if (isBranchOrCall(instruction.extOpcode >> 1))
+			instruction.target = findDecodedInstruction(nextOffset + instruction.opparams[0]);
+	}
+}
+
 } // End of namespace Sci
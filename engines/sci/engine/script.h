@@ -69,6 +69,23 @@ struct offsetLookupArrayEntry {
 
 typedef Common::Array<offsetLookupArrayEntry> offsetLookupArrayType;
 
+/**
+ * A PMachine instruction as decoded by readPMachineInstruction(), see
+ * Script::readInstruction().
+ */
+struct DecodedInstruction {
+	uint32 offset;      ///< Offset of the instruction in the script
+	byte extOpcode;
+	byte size;          ///< Size of the instruction in bytes
+	uint16 next;        ///< Slot of the following instruction, or kNoDecodedInstruction
+	uint16 target;      ///< Slot of the branch or call target, or kNoDecodedInstruction
+	int16 opparams[3];
+};
+
+enum {
+	kNoDecodedInstruction = 0xFFFF
+};
+
 class Script : public SegmentObj {
 private:
 	int _nr; /**< Script number */
@@ -94,6 +111,16 @@ private:
 
 	ObjMap _objects;	/**< Table for objects, contains property variables */
 
+	/**
+	 * The decoded instructions of the script. Only the instructions which
+	 * are reachable from code that has been executed are decoded.
+	 */
+	Common::Array<DecodedInstruction> _decodedInstructions;
+	/** Slots of the decoded instructions, sorted by their offset */
+	Common::Array<uint16> _decodedInstructionIndex;
+	/** Slot of the instruction read last, to predict the next one */
+	uint16 _lastDecodedInstruction;
+
 protected:
 	offsetLookupArrayType _offsetLookupArray; // Table of all elements of currently loaded script, that may get pointed to
 
@@ -128,6 +155,31 @@ public:
 	const ObjMap &getObjectMap() const { return _objects; }
 	bool offsetIsObject(uint32 offset) const;
 
+	/**
+	 * Reads the instruction at the given offset, like readPMachineInstruction()
+	 * does. When code at an offset is executed for the first time, all code
+	 * reachable from there is decoded, and then kept in decoded form until the
+	 * script is freed.
+	 * @return the size of the instruction in bytes
+	 */
+	int readInstruction(uint32 offset, byte &extOpcode, int16 opparams[4]);
+
+private:
+	/**
+	 * Returns the slot of the decoded instruction at the given offset, or
+	 * kNoDecodedInstruction if it has not been decoded yet.
+	 */
+	uint16 findDecodedInstruction(uint32 offset) const;
+
+	/**
+	 * Decodes the instructions at the given offset and everything reachable
+	 * from there by falling through, branching or calling local procedures.
+	 */
+	void decodeInstructions(uint32 offset);
+
+	/** Checks whether the instruction at the given offset may be decoded in advance. */
+	bool canDecodeInstruction(uint32 offset) const;
+
 public:
 	Script();
 	~Script();
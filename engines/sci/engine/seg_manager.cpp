@@ -43,6 +43,10 @@ SegManager::SegManager(ResourceManager *resMan, ScriptPatcher *scriptPatcher)
 	_saveDirPtr = NULL_REG;
 	_parserPtr = NULL_REG;
 
+	_selectorCacheHits = 0;
+	_selectorCacheMisses = 0;
+	_selectorCacheFlushes = 0;
+
 #ifdef ENABLE_SCI32
 	_arraysSegId = 0;
 	_bitmapSegId = 0;
@@ -167,6 +171,7 @@ void SegManager::deallocate(SegmentId seg) {
 	if (mobj->getType() == SEG_TYPE_SCRIPT) {
 		Script *scr = (Script *)mobj;
 		_scriptSegMap.erase(scr->getScriptNumber());
+		flushSelectorCache();
 		if (scr->getLocalsSegment()) {
 			// Check if the locals segment has already been deallocated.
 			// If the locals block has been stored in a segment with an ID
@@ -184,6 +189,43 @@ void SegManager::deallocate(SegmentId seg) {
 	_heap[actualSegment] = NULL;
 }
 
+const SelectorCacheEntry *SegManager::getCachedSelector(reg_t pos, Selector selectorId) {
+	SelectorCacheKey key;
+	key.pos = pos;
+	key.selectorId = selectorId;
+
+	SelectorCache::const_iterator i = _selectorCache.find(key);
+	if (i == _selectorCache.end()) {
+		_selectorCacheMisses++;
+		return NULL;
+	}
+
+	_selectorCacheHits++;
+	return &i->_value;
+}
+
+void SegManager::cacheSelector(reg_t pos, Selector selectorId, const SelectorCacheEntry &entry) {
+	SelectorCacheKey key;
+	key.pos = pos;
+	key.selectorId = selectorId;
+	_selectorCache[key] = entry;
+}
+
+void SegManager::flushSelectorCache() {
+	if (_selectorCache.empty())
+		return;
+
+	_selectorCache.clear(true);
+	_selectorCacheFlushes++;
+}
+
+void SegManager::getSelectorCacheStats(uint32 &hits, uint32 &misses, uint32 &flushes, uint &entries) const {
+	hits = _selectorCacheHits;
+	misses = _selectorCacheMisses;
+	flushes = _selectorCacheFlushes;
+	entries = _selectorCache.size();
+}
+
 bool SegManager::isHeapObject(reg_t pos) const {
 	const Object *obj = getObject(pos);
 	if (obj == NULL || (obj && obj->isFreed()))
@@ -1028,6 +1070,7 @@ int SegManager::instantiateScript(int scriptNum) {
 		scr = allocateScript(scriptNum, &segmentId);
 	}
 
+	flushSelectorCache();
 	scr->load(scriptNum, _resMan, _scriptPatcher);
 	scr->initializeLocals(this);
 	scr->initializeClasses(this);
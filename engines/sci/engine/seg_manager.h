@@ -46,6 +46,32 @@ enum ScriptLoadType {
 
 class Script;
 
+/**
+ * The result of a selector lookup, as cached by the segment manager. Clones
+ * share the methods and variables of the script object they were cloned
+ * from, so the lookups are keyed by the address of that script object.
+ */
+struct SelectorCacheEntry {
+	SelectorType type;
+	int varIndex;
+	reg_t func;
+};
+
+struct SelectorCacheKey {
+	reg_t pos;
+	Selector selectorId;
+
+	bool operator==(const SelectorCacheKey &other) const {
+		return pos == other.pos && selectorId == other.selectorId;
+	}
+};
+
+struct SelectorCacheKey_Hash {
+	uint operator()(const SelectorCacheKey &x) const {
+		return (x.pos.getSegment() << 3) ^ x.pos.getOffset() ^ (x.selectorId << 16);
+	}
+};
+
 class SegManager : public Common::Serializable {
 	friend class Console;
 public:
@@ -436,6 +462,30 @@ public:
 	reg_t getSaveDirPtr() const { return _saveDirPtr; }
 	reg_t getParserPtr() const { return _parserPtr; }
 
+	// 10. Selector lookup cache
+
+	/**
+	 * Finds a cached selector lookup.
+	 * @param pos			The address of the script object the looked up
+	 *						object was defined or cloned from
+	 * @param selectorId	The selector to look up
+	 * @return				The cached lookup, or NULL if there is none
+	 */
+	const SelectorCacheEntry *getCachedSelector(reg_t pos, Selector selectorId);
+
+	/**
+	 * Caches the result of a selector lookup, see getCachedSelector().
+	 */
+	void cacheSelector(reg_t pos, Selector selectorId, const SelectorCacheEntry &entry);
+
+	/**
+	 * Drops all cached selector lookups. This is done whenever a script is
+	 * loaded or unloaded.
+	 */
+	void flushSelectorCache();
+
+	void getSelectorCacheStats(uint32 &hits, uint32 &misses, uint32 &flushes, uint &entries) const;
+
 #ifdef ENABLE_SCI32
 	bool isValidAddr(reg_t reg, SegmentType expected) const {
 		SegmentObj *mobj = getSegmentObj(reg.getSegment());
@@ -470,6 +520,12 @@ private:
 	SegmentId _nodesSegId; ///< ID of the (a) node segment
 	SegmentId _hunksSegId; ///< ID of the (a) hunk segment
 
+	typedef Common::HashMap<SelectorCacheKey, SelectorCacheEntry, SelectorCacheKey_Hash> SelectorCache;
+	SelectorCache _selectorCache;
+	uint32 _selectorCacheHits;
+	uint32 _selectorCacheMisses;
+	uint32 _selectorCacheFlushes;
+
 	// Statically allocated memory for system strings
 	reg_t _saveDirPtr;
 	reg_t _parserPtr;
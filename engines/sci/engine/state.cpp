@@ -75,6 +75,7 @@ EngineState::EngineState(SegManager *segMan)
 
 EngineState::~EngineState() {
 	delete _msgState;
+	freeVisibilityGraphs(_visibilityGraphs);
 }
 
 void EngineState::reset(bool isRestoring) {
@@ -100,6 +101,7 @@ void EngineState::reset(bool isRestoring) {
 	lastWaitTime = 0;
 
 	gcCountDown = 0;
+	gcStats = GCStatistics();
 
 #ifdef ENABLE_SCI32
 	_eventCounter = 0;
@@ -116,6 +118,7 @@ void EngineState::reset(bool isRestoring) {
 	_cursorWorkaroundActive = false;
 
 	scriptStepCounter = 0;
+	scriptSendCounter = 0;
 	scriptGCInterval = GC_INTERVAL;
 
 	_videoState.reset();
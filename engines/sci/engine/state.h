@@ -49,6 +49,12 @@ class EventManager;
 class MessageState;
 class SoundCommandParser;
 class VirtualIndexFile;
+struct VisibilityGraph;
+
+/**
+ * Frees the visibility graphs cached by kAvoidPath. Refer to kpathing.cpp
+ */
+void freeVisibilityGraphs(Common::List<VisibilityGraph *> &graphs);
 
 enum AbortGameState {
 	kAbortNone = 0,
@@ -95,6 +101,23 @@ struct VideoState {
 	}
 };
 
+/**
+ * Statistics about the garbage collections, shown by the debugger.
+ */
+struct GCStatistics {
+	uint32 runs; ///< Number of garbage collections
+	uint32 lastMarkTime; ///< Time spent finding the active references in the last run, in ms
+	uint32 lastSweepTime; ///< Time spent freeing unused objects in the last run, in ms
+	uint32 maxPauseTime; ///< Longest run, in ms
+	uint32 totalPauseTime; ///< Time spent in all runs, in ms
+	uint lastReachable; ///< Number of active references found in the last run
+	uint lastFreed; ///< Number of objects freed in the last run
+	uint32 totalFreed; ///< Number of objects freed in all runs
+
+	GCStatistics() : runs(0), lastMarkTime(0), lastSweepTime(0), maxPauseTime(0),
+		totalPauseTime(0), lastReachable(0), lastFreed(0), totalFreed(0) {}
+};
+
 /**
  * Trace information about a VM function call.
  */
@@ -184,6 +207,7 @@ public:
 	int16 gameIsRestarting; // is set when restarting (=1) or restoring the game (=2)
 
 	int scriptStepCounter; // Counts the number of steps executed
+	uint32 scriptSendCounter; // Counts the number of selectors sent to objects
 	int scriptGCInterval; // Number of steps in between gcs
 
 	uint16 currentRoomNumber() const;
@@ -201,6 +225,9 @@ public:
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	GCStatistics gcStats; /**< Statistics about the garbage collections */
+
+	Common::List<VisibilityGraph *> _visibilityGraphs; /**< Visibility graphs of recently used polygon sets, used by kAvoidPath */
 
 	MessageState *_msgState;
 
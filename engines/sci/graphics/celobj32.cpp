@@ -86,20 +86,13 @@ bool CelObj::_drawBlackLines = false;
 void CelObj::init() {
 	CelObj::deinit();
 	_drawBlackLines = false;
-	_nextCacheId = 1;
 	_scaler = new CelScaler();
-	_cache = new CelCache;
-	_cache->resize(100);
+	_cache = new CelCache(kCelCacheDefaultSize);
 }
 
 void CelObj::deinit() {
 	delete _scaler;
 	_scaler = nullptr;
-	if (_cache != nullptr) {
-		for (CelCache::iterator it = _cache->begin(); it != _cache->end(); ++it) {
-			delete it->celObj;
-		}
-	}
 	delete _cache;
 	_cache = nullptr;
 }
@@ -296,7 +289,9 @@ public:
 
 struct READER_Compressed {
 private:
-	const SciSpan<const byte> _resource;
+	const byte *const _pixels;
+	const int16 _sourceWidth;
+	SciSpan<const byte> _resource;
 	byte _buffer[kCelScalerTableSize];
 	uint32 _controlOffset;
 	uint32 _dataOffset;
@@ -308,13 +303,20 @@ private:
 
 public:
 	READER_Compressed(const CelObj &celObj, const int16 maxWidth) :
-	_resource(celObj.getResPointer()),
+	_pixels(celObj._decompressedPixels.get()),
+	_sourceWidth(celObj._width),
 	_y(-1),
 	_sourceHeight(celObj._height),
 	_skipColor(celObj._skipColor),
 	_maxWidth(maxWidth) {
 		assert(maxWidth <= celObj._width);
 
+		// Cels from the cel cache are already decompressed
+		if (_pixels) {
+			return;
+		}
+
+		_resource = celObj.getResPointer();
 		const SciSpan<const byte> celHeader = _resource.subspan(celObj._celHeaderOffset);
 		_dataOffset = celHeader.getUint32SEAt(24);
 		_uncompressedDataOffset = celHeader.getUint32SEAt(28);
@@ -323,6 +325,10 @@ public:
 
 	inline const byte *getRow(const int16 y) {
 		assert(y >= 0 && y < _sourceHeight);
+		if (_pixels) {
+			return _pixels + y * _sourceWidth;
+		}
+
 		if (y != _y) {
 			// compressed data segment for row
 			const uint32 rowOffset = _resource.getUint32SEAt(_controlOffset + y * sizeof(uint32));
@@ -611,50 +617,113 @@ void CelObj::submitPalette() const {
 #pragma mark -
 #pragma mark CelObj - Caching
 
-int CelObj::_nextCacheId = 1;
 CelCache *CelObj::_cache = nullptr;
 
-int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) const {
-	*nextInsertIndex = -1;
-	int oldestId = _nextCacheId + 1;
-	int oldestIndex = 0;
+CelCache::CelCache(const uint32 maxSize) :
+	_maxSize(maxSize),
+	_size(0),
+	_hits(0),
+	_misses(0),
+	_evictions(0) {}
 
-	for (int i = 0, len = _cache->size(); i < len; ++i) {
-		CelCacheEntry &entry = (*_cache)[i];
+CelCache::~CelCache() {
+	clear();
+}
 
-		if (entry.celObj == nullptr) {
-			if (*nextInsertIndex == -1) {
-				*nextInsertIndex = i;
-			}
-		} else if (entry.celObj->_info == celInfo) {
-			entry.id = ++_nextCacheId;
-			return i;
-		} else if (oldestId > entry.id) {
-			oldestId = entry.id;
-			oldestIndex = i;
-		}
+const CelObj *CelCache::find(const CelInfo32 &celInfo) {
+	EntryMap::iterator it = _entries.find(celInfo);
+	if (it == _entries.end()) {
+		++_misses;
+		return nullptr;
+	}
+
+	++_hits;
+	CelCacheEntry &entry = it->_value;
+	if (entry.lruPosition != _lru.begin()) {
+		_lru.erase(entry.lruPosition);
+		_lru.push_front(celInfo);
+		entry.lruPosition = _lru.begin();
+	}
+	return entry.celObj;
+}
+
+void CelCache::insert(CelObj *celObj, const uint32 size) {
+	const CelInfo32 &celInfo = celObj->_info;
+
+	EntryMap::iterator it = _entries.find(celInfo);
+	if (it != _entries.end()) {
+		CelCacheEntry &entry = it->_value;
+		_lru.erase(entry.lruPosition);
+		_size -= entry.size;
+		delete entry.celObj;
 	}
 
-	if (*nextInsertIndex == -1) {
-		*nextInsertIndex = oldestIndex;
+	_lru.push_front(celInfo);
+
+	CelCacheEntry &entry = _entries[celInfo];
+	entry.celObj = celObj;
+	entry.size = size;
+	entry.lruPosition = _lru.begin();
+	_size += size;
+
+	shrink();
+}
+
+void CelCache::shrink() {
+	// The most recently used cel is kept even if it is
+	// larger than the whole cache
+	while (_size > _maxSize && _entries.size() > 1) {
+		EntryMap::iterator it = _entries.find(_lru.back());
+		assert(it != _entries.end());
+		_size -= it->_value.size;
+		delete it->_value.celObj;
+		_entries.erase(it);
+		_lru.pop_back();
+		++_evictions;
 	}
+}
+
+void CelCache::clear() {
+	for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		delete it->_value.celObj;
+	}
+	_entries.clear();
+	_lru.clear();
+	_size = 0;
+}
 
-	return -1;
+void CelCache::setMaxSize(const uint32 maxSize) {
+	_maxSize = maxSize;
+	shrink();
 }
 
-void CelObj::putCopyInCache(const int cacheIndex) const {
-	if (cacheIndex == -1) {
-		error("Invalid cache index");
+struct PixelsDeleter {
+	void operator()(byte *pixels) const {
+		delete[] pixels;
 	}
+};
 
-	CelCacheEntry &entry = (*_cache)[cacheIndex];
+void CelObj::decompressPixels() {
+	byte *pixels = new byte[_width * _height];
 
-	if (entry.celObj != nullptr) {
-		delete entry.celObj;
+	READER_Compressed reader(*this, _width);
+	for (int16 y = 0; y < _height; ++y) {
+		memcpy(pixels + y * _width, reader.getRow(y), _width);
+	}
+
+	_decompressedPixels = Common::SharedPtr<byte>(pixels, PixelsDeleter());
+}
+
+void CelObj::putCopyInCache() {
+	uint32 size = sizeof(CelObj);
+	if (_compressionType == kCelCompressionRLE) {
+		if (!_decompressedPixels) {
+			decompressPixels();
+		}
+		size += _width * _height;
 	}
 
-	entry.celObj = duplicate();
-	entry.id = ++_nextCacheId;
+	_cache->insert(duplicate(), size);
 }
 
 #pragma mark -
@@ -900,16 +969,13 @@ CelObjView::CelObjView(const GuiResourceId viewId, const int16 loopNo, const int
 	_compressionType = kCelCompressionInvalid;
 	_transparent = true;
 
-	int cacheInsertIndex;
-	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
-	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
-		const CelObjView *const cachedCelObj = dynamic_cast<CelObjView *>(entry.celObj);
+	const CelObj *const cachedCel = _cache->find(_info);
+	if (cachedCel != nullptr) {
+		const CelObjView *const cachedCelObj = dynamic_cast<const CelObjView *>(cachedCel);
 		if (cachedCelObj == nullptr) {
-			error("Expected a CelObjView in cache slot %d", cacheIndex);
+			error("Expected a CelObjView in the cache for %s", _info.toString().c_str());
 		}
 		*this = *cachedCelObj;
-		entry.id = ++_nextCacheId;
 		return;
 	}
 
@@ -1026,7 +1092,7 @@ CelObjView::CelObjView(const GuiResourceId viewId, const int16 loopNo, const int
 		_remap = analyzeForRemap();
 	}
 
-	putCopyInCache(cacheInsertIndex);
+	putCopyInCache();
 }
 
 bool CelObjView::analyzeUncompressedForRemap() const {
@@ -1094,16 +1160,13 @@ CelObjPic::CelObjPic(const GuiResourceId picId, const int16 celNo) {
 	_transparent = true;
 	_remap = false;
 
-	int cacheInsertIndex;
-	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
-	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
-		const CelObjPic *const cachedCelObj = dynamic_cast<CelObjPic *>(entry.celObj);
+	const CelObj *const cachedCel = _cache->find(_info);
+	if (cachedCel != nullptr) {
+		const CelObjPic *const cachedCelObj = dynamic_cast<const CelObjPic *>(cachedCel);
 		if (cachedCelObj == nullptr) {
-			error("Expected a CelObjPic in cache slot %d", cacheIndex);
+			error("Expected a CelObjPic in the cache for %s", _info.toString().c_str());
 		}
 		*this = *cachedCelObj;
-		entry.id = ++_nextCacheId;
 		return;
 	}
 
@@ -1168,7 +1231,7 @@ CelObjPic::CelObjPic(const GuiResourceId picId, const int16 celNo) {
 		}
 	}
 
-	putCopyInCache(cacheInsertIndex);
+	putCopyInCache();
 }
 
 bool CelObjPic::analyzeUncompressedForSkip() const {
@@ -23,6 +23,9 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/ptr.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource.h"
@@ -110,7 +113,7 @@ struct CelInfo32 {
 	// NOTE: This is the equivalence criteria used by
 	// CelObj::searchCache in at least SCI2.1/SQ6. Notably,
 	// it does not check the color field.
-	inline bool operator==(const CelInfo32 &other) {
+	inline bool operator==(const CelInfo32 &other) const {
 		return (
 			type == other.type &&
 			resourceId == other.resourceId &&
@@ -120,7 +123,7 @@ struct CelInfo32 {
 		);
 	}
 
-	inline bool operator!=(const CelInfo32 &other) {
+	inline bool operator!=(const CelInfo32 &other) const {
 		return !(*this == other);
 	}
 
@@ -140,19 +143,108 @@ struct CelInfo32 {
 	}
 };
 
+struct CelInfo32_Hash {
+	uint operator()(const CelInfo32 &info) const {
+		return ((uint)info.type << 28) ^ ((uint)info.resourceId << 12) ^ ((uint16)info.loopNo << 6) ^
+			(uint16)info.celNo ^ (info.bitmap.getSegment() << 16) ^ info.bitmap.getOffset();
+	}
+};
+
 class CelObj;
 struct CelCacheEntry {
 	/**
-	 * A monotonically increasing cache ID used to identify
-	 * the least recently used item in the cache for
-	 * replacement.
+	 * The cached cel object.
 	 */
-	int id;
 	CelObj *celObj;
-	CelCacheEntry() : id(0), celObj(nullptr) {}
+
+	/**
+	 * The memory used by the cel object and its
+	 * decompressed pixel data, in bytes.
+	 */
+	uint32 size;
+
+	/**
+	 * The position of this entry in the list of least
+	 * recently used entries.
+	 */
+	Common::List<CelInfo32>::iterator lruPosition;
+
+	CelCacheEntry() : celObj(nullptr), size(0) {}
+};
+
+enum {
+	/**
+	 * The default maximum amount of memory used by the
+	 * cel cache, in bytes.
+	 */
+	kCelCacheDefaultSize = 16 * 1024 * 1024
 };
 
-typedef Common::Array<CelCacheEntry> CelCache;
+/**
+ * A cache of cel objects, which is bounded by the memory
+ * used by the cels. When the cache is full, the least
+ * recently used cels are removed.
+ */
+class CelCache {
+public:
+	CelCache(const uint32 maxSize);
+	~CelCache();
+
+	/**
+	 * Returns the cel object matching the given CelInfo32
+	 * and marks it as most recently used, or returns null
+	 * if there is no such cel in the cache.
+	 */
+	const CelObj *find(const CelInfo32 &celInfo);
+
+	/**
+	 * Puts the given cel object into the cache, which
+	 * takes ownership of it. Least recently used cels are
+	 * removed to keep the cache within its size limit.
+	 */
+	void insert(CelObj *celObj, const uint32 size);
+
+	/**
+	 * Removes all cels from the cache.
+	 */
+	void clear();
+
+	/**
+	 * Changes the maximum amount of memory used by the
+	 * cached cels, in bytes.
+	 */
+	void setMaxSize(const uint32 maxSize);
+
+	uint32 getMaxSize() const { return _maxSize; }
+	uint32 getSize() const { return _size; }
+	uint getNumEntries() const { return _entries.size(); }
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+	uint32 getEvictions() const { return _evictions; }
+
+private:
+	typedef Common::HashMap<CelInfo32, CelCacheEntry, CelInfo32_Hash> EntryMap;
+
+	/**
+	 * Removes least recently used cels until the cache is
+	 * within its size limit.
+	 */
+	void shrink();
+
+	EntryMap _entries;
+
+	/**
+	 * The keys of all entries, ordered from the most
+	 * recently used to the least recently used.
+	 */
+	Common::List<CelInfo32> _lru;
+
+	uint32 _maxSize;
+	uint32 _size;
+	uint32 _hits;
+	uint32 _misses;
+	uint32 _evictions;
+};
 
 #pragma mark -
 #pragma mark CelScaler
@@ -343,6 +435,15 @@ public:
 	 */
 	bool _remap;
 
+	/**
+	 * The decompressed pixel data of a compressed cel,
+	 * which is shared by all copies of the cel. This is
+	 * created when the cel is put into the cel cache, so
+	 * that drawing the cel doesn't need to decompress it
+	 * again.
+	 */
+	Common::SharedPtr<byte> _decompressedPixels;
+
 	/**
 	 * If true, the cel contains pre-mirrored picture data.
 	 * This value comes directly from the resource data and
@@ -468,35 +569,33 @@ private:
 
 #pragma mark -
 #pragma mark CelObj - Caching
-protected:
+public:
 	/**
-	 * A monotonically increasing cache ID used to identify
-	 * the least recently used item in the cache for
-	 * replacement.
+	 * Returns the cache of cel objects.
 	 */
-	static int _nextCacheId;
+	static CelCache *getCache() { return _cache; }
 
+protected:
 	/**
 	 * A cache of cel objects used to avoid reinitialisation
 	 * overhead for cels with the same CelInfo32.
 	 */
-	// NOTE: At least SQ6 uses a fixed cache size of 100.
+	// NOTE: At least SQ6 uses a fixed cache size of 100
+	// cels. The cache here is bounded by memory instead,
+	// since cels of high resolution games are much larger.
 	static CelCache *_cache;
 
 	/**
-	 * Searches the cel cache for a CelObj matching the
-	 * provided CelInfo32. If not found, -1 is returned.
-	 * nextInsertIndex will receive the index of the oldest
-	 * item in the cache, which can be used to replace
-	 * the oldest item with a newer item.
+	 * Decompresses the pixel data of a compressed cel
+	 * into `_decompressedPixels`.
 	 */
-	int searchCache(const CelInfo32 &celInfo, int *nextInsertIndex) const;
+	void decompressPixels();
 
 	/**
-	 * Puts a copy of this CelObj into the cache at the
-	 * given cache index.
+	 * Puts a copy of this CelObj into the cache. The pixel
+	 * data of compressed cels is decompressed first.
 	 */
-	void putCopyInCache(int index) const;
+	void putCopyInCache();
 };
 
 #pragma mark -
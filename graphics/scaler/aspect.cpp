@@ -25,6 +25,9 @@
 
 #ifdef USE_ARM_NEON_ASPECT_CORRECTOR
 #include <arm_neon.h>
+#elif defined(__SSE2__)
+#define USE_SSE2_ASPECT_CORRECTOR
+#include <emmintrin.h>
 #endif
 
 #define	kSuperFastAndUglyAspectMode	0	// No interpolation at all, but super-fast
@@ -95,6 +98,40 @@ static void interpolate5LineNeon(uint16 *dst, const uint16 *srcA, const uint16 *
 }
 #endif // USE_ARM_NEON_ASPECT_CORRECTOR
 
+#ifdef USE_SSE2_ASPECT_CORRECTOR
+
+static inline __m128i interpolateChannelSSE2(__m128i p1, __m128i p2, __m128i mask, __m128i k1, __m128i k2) {
+	// The channel values times 8 have to fit into 16 bits
+	__m128i sum = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(p1, mask), k1), _mm_mullo_epi16(_mm_and_si128(p2, mask), k2));
+	return _mm_and_si128(_mm_srli_epi16(sum, 3), mask);
+}
+
+template<typename ColorMask>
+static void interpolate5LineSSE2(uint16 *dst, const uint16 *srcA, const uint16 *srcB, int width, int k1, int k2) {
+	const __m128i redMask = _mm_set1_epi16(ColorMask::kRedMask >> 8);
+	const __m128i greenMask = _mm_set1_epi16(ColorMask::kGreenMask);
+	const __m128i blueMask = _mm_set1_epi16(ColorMask::kBlueMask);
+	const __m128i k1_8 = _mm_set1_epi16(k1);
+	const __m128i k2_8 = _mm_set1_epi16(k2);
+	while (width >= 8) {
+		__m128i p1 = _mm_loadu_si128((const __m128i *)srcB);
+		__m128i p2 = _mm_loadu_si128((const __m128i *)srcA);
+
+		// Red is interpolated shifted down, so that it does not overflow
+		__m128i red = interpolateChannelSSE2(_mm_srli_epi16(p1, 8), _mm_srli_epi16(p2, 8), redMask, k1_8, k2_8);
+		__m128i green = interpolateChannelSSE2(p1, p2, greenMask, k1_8, k2_8);
+		__m128i blue = interpolateChannelSSE2(p1, p2, blueMask, k1_8, k2_8);
+
+		_mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_slli_epi16(red, 8), _mm_or_si128(green, blue)));
+
+		dst += 8;
+		srcA += 8;
+		srcB += 8;
+		width -= 8;
+	}
+}
+#endif // USE_SSE2_ASPECT_CORRECTOR
+
 template<typename ColorMask, int scale>
 static void interpolate5Line(uint16 *dst, const uint16 *srcA, const uint16 *srcB, int width) {
 	if (scale == 1) {
@@ -106,6 +143,14 @@ static void interpolate5Line(uint16 *dst, const uint16 *srcA, const uint16 *srcB
 		dst += width4;
 		width -= width4;
 #endif // USE_ARM_NEON_ASPECT_CORRECTOR
+#ifdef USE_SSE2_ASPECT_CORRECTOR
+		int width8 = width & ~7;
+		interpolate5LineSSE2<ColorMask>(dst, srcA, srcB, width8, 7, 1);
+		srcA += width8;
+		srcB += width8;
+		dst += width8;
+		width -= width8;
+#endif // USE_SSE2_ASPECT_CORRECTOR
 		while (width--) {
 			*dst++ = interpolate16_7_1<ColorMask>(*srcB++, *srcA++);
 		}
@@ -118,6 +163,14 @@ static void interpolate5Line(uint16 *dst, const uint16 *srcA, const uint16 *srcB
 		dst += width4;
 		width -= width4;
 #endif // USE_ARM_NEON_ASPECT_CORRECTOR
+#ifdef USE_SSE2_ASPECT_CORRECTOR
+		int width8 = width & ~7;
+		interpolate5LineSSE2<ColorMask>(dst, srcA, srcB, width8, 5, 3);
+		srcA += width8;
+		srcB += width8;
+		dst += width8;
+		width -= width8;
+#endif // USE_SSE2_ASPECT_CORRECTOR
 		while (width--) {
 			*dst++ = interpolate16_5_3<ColorMask>(*srcB++, *srcA++);
 		}
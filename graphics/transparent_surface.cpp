@@ -37,6 +37,11 @@
 #include "graphics/transparent_surface.h"
 #include "graphics/transform_tools.h"
 
+#if defined(__SSE2__) && defined(SCUMM_LITTLE_ENDIAN)
+#define USE_SSE2_BLENDING
+#include <emmintrin.h>
+#endif
+
 namespace Graphics {
 
 static const int kBModShift = 0;//img->format.bShift;
@@ -64,6 +69,172 @@ void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
 void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
 
+#ifdef USE_SSE2_BLENDING
+
+/**
+ * The SSE2 blending kernels work on two pixels at a time, which are widened
+ * to 16 bits per channel. This gives the lane order A, B, G, R per pixel.
+ * All kernels produce exactly the same results as the scalar code, including
+ * its wrap arounds, so the remaining pixels of a row can be blended by the
+ * scalar loops.
+ */
+struct BlendColorSSE2 {
+	BlendColorSSE2(uint32 color) {
+		const int16 ca = (color >> kAModShift) & 0xFF;
+		const int16 cr = (color >> kRModShift) & 0xFF;
+		const int16 cg = (color >> kGModShift) & 0xFF;
+		const int16 cb = (color >> kBModShift) & 0xFF;
+
+		mod = _mm_set_epi16(cr, cg, cb, ca, cr, cg, cb, ca);
+		alpha = _mm_set1_epi16(ca);
+		full = _mm_cmpeq_epi16(mod, _mm_set1_epi16(255));
+	}
+
+	__m128i mod;   ///< The color modulation of each channel
+	__m128i alpha; ///< The alpha modulation in all channels
+	__m128i full;  ///< Set for the channels without color modulation
+};
+
+static inline __m128i broadcastAlphaSSE2(__m128i pixels) {
+	return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, 0), 0);
+}
+
+static inline __m128i selectSSE2(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static inline __m128i alphaLaneSSE2() {
+	return _mm_set_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+}
+
+static inline __m128i modulatedAlphaSSE2(__m128i in, const BlendColorSSE2 &c) {
+	return _mm_srli_epi16(_mm_mullo_epi16(broadcastAlphaSSE2(in), c.alpha), 8);
+}
+
+/** Computes in * ina * mod >> 16, or in * ina >> 8 for unmodulated channels. */
+static inline __m128i modulatedColorSSE2(__m128i in, __m128i ina, const BlendColorSSE2 &c) {
+	const __m128i product = _mm_mullo_epi16(in, ina);
+	return selectSSE2(c.full, _mm_srli_epi16(product, 8), _mm_mulhi_epu16(product, c.mod));
+}
+
+struct AlphaBlendSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendColorSSE2 &) {
+		const __m128i c255 = _mm_set1_epi16(255);
+		const __m128i a = broadcastAlphaSSE2(in);
+		__m128i res = _mm_add_epi16(_mm_mullo_epi16(in, a), _mm_mullo_epi16(out, _mm_sub_epi16(c255, a)));
+		res = selectSSE2(alphaLaneSSE2(), c255, _mm_srli_epi16(res, 8));
+		return selectSSE2(_mm_cmpeq_epi16(a, _mm_setzero_si128()), out, res);
+	}
+};
+
+struct AlphaBlendColorSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendColorSSE2 &c) {
+		const __m128i c255 = _mm_set1_epi16(255);
+		const __m128i ina = modulatedAlphaSSE2(in, c);
+		const __m128i dst = _mm_srli_epi16(_mm_mullo_epi16(out, _mm_sub_epi16(c255, ina)), 8);
+		const __m128i src = _mm_mulhi_epu16(_mm_mullo_epi16(in, ina), c.mod);
+		// The sum is truncated to a byte like in the scalar code
+		return selectSSE2(alphaLaneSSE2(), c255, _mm_and_si128(_mm_add_epi16(dst, src), c255));
+	}
+};
+
+struct AdditiveBlendSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendColorSSE2 &) {
+		const __m128i a = broadcastAlphaSSE2(in);
+		__m128i res = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(in, a), 8), out);
+		res = selectSSE2(alphaLaneSSE2(), out, _mm_min_epi16(res, _mm_set1_epi16(255)));
+		return selectSSE2(_mm_cmpeq_epi16(a, _mm_setzero_si128()), out, res);
+	}
+};
+
+struct AdditiveBlendColorSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendColorSSE2 &c) {
+		const __m128i res = _mm_add_epi16(out, modulatedColorSSE2(in, modulatedAlphaSSE2(in, c), c));
+		return selectSSE2(alphaLaneSSE2(), out, _mm_min_epi16(res, _mm_set1_epi16(255)));
+	}
+};
+
+struct SubtractiveBlendSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendColorSSE2 &) {
+		const __m128i a = broadcastAlphaSSE2(in);
+		__m128i res = _mm_sub_epi16(out, _mm_mulhi_epu16(_mm_mullo_epi16(in, out), a));
+		res = selectSSE2(alphaLaneSSE2(), out, res);
+		return selectSSE2(_mm_cmpeq_epi16(a, _mm_setzero_si128()), out, res);
+	}
+};
+
+struct SubtractiveBlendColorSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendColorSSE2 &c) {
+		const __m128i c255 = _mm_set1_epi16(255);
+		const __m128i a = broadcastAlphaSSE2(in);
+		const __m128i inOut = _mm_mullo_epi16(in, out);
+		const __m128i modAlpha = _mm_mullo_epi16(c.mod, a);
+
+		// The scalar code computes in * mod * out * a >> 24 in an int, which
+		// wraps around for large products. Do the same with 32 bit lanes.
+		const __m128i lo = _mm_mullo_epi16(inOut, modAlpha);
+		const __m128i hi = _mm_mulhi_epu16(inOut, modAlpha);
+		const __m128i modulated = _mm_packs_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 24),
+		                                          _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 24));
+
+		const __m128i sub = selectSSE2(c.full, _mm_mulhi_epu16(inOut, a), modulated);
+		return selectSSE2(alphaLaneSSE2(), c255, _mm_and_si128(_mm_sub_epi16(out, sub), c255));
+	}
+};
+
+struct MultiplyBlendSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendColorSSE2 &) {
+		const __m128i a = broadcastAlphaSSE2(in);
+		__m128i res = _mm_srli_epi16(_mm_mullo_epi16(in, a), 8);
+		res = selectSSE2(alphaLaneSSE2(), out, _mm_srli_epi16(_mm_mullo_epi16(res, out), 8));
+		return selectSSE2(_mm_cmpeq_epi16(a, _mm_setzero_si128()), out, res);
+	}
+};
+
+struct MultiplyBlendColorSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendColorSSE2 &c) {
+		const __m128i src = modulatedColorSSE2(in, modulatedAlphaSSE2(in, c), c);
+		return selectSSE2(alphaLaneSSE2(), out, _mm_srli_epi16(_mm_mullo_epi16(out, src), 8));
+	}
+};
+
+/**
+ * Blends four pixels at a time of a row, as long as the source pixels are
+ * adjacent. Advances in and out past the blended pixels.
+ * @return the number of pixels blended
+ */
+template<class Kernel>
+static uint32 blendRowSSE2(byte *&in, byte *&out, uint32 width, int32 inStep, uint32 color) {
+	if (inStep != 4 && inStep != -4)
+		return 0;
+
+	const BlendColorSSE2 c(color);
+	const __m128i zero = _mm_setzero_si128();
+	uint32 j = 0;
+
+	for (; j + 4 <= width; j += 4) {
+		__m128i src;
+		if (inStep > 0) {
+			src = _mm_loadu_si128((const __m128i *)in);
+		} else {
+			// Horizontally flipped: load the preceding pixels and reverse them
+			src = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(in - 12)), _MM_SHUFFLE(0, 1, 2, 3));
+		}
+		const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+
+		const __m128i lo = Kernel::blend(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero), c);
+		const __m128i hi = Kernel::blend(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero), c);
+		_mm_storeu_si128((__m128i *)out, _mm_packus_epi16(lo, hi));
+
+		in += 4 * inStep;
+		out += 16;
+	}
+
+	return j;
+}
+
+#endif
+
 TransparentSurface::TransparentSurface() : Surface(), _alphaMode(ALPHA_FULL) {}
 
 TransparentSurface::TransparentSurface(const Surface &surf, bool copyData) : Surface(), _alphaMode(ALPHA_FULL) {
@@ -149,7 +320,11 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<AlphaBlendSSE2>(in, out, width, inStep, color);
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kAIndex] = 255;
@@ -174,7 +349,11 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<AlphaBlendColorSSE2>(in, out, width, inStep, color);
+#endif
+			for (; j < width; j++) {
 
 				uint32 ina = in[kAIndex] * ca >> 8;
 				out[kAIndex] = 255;
@@ -207,7 +386,11 @@ void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<AdditiveBlendSSE2>(in, out, width, inStep, color);
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kRIndex] = MIN((in[kRIndex] * in[kAIndex] >> 8) + out[kRIndex], 255);
@@ -231,7 +414,11 @@ void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<AdditiveBlendColorSSE2>(in, out, width, inStep, color);
+#endif
+			for (; j < width; j++) {
 
 				uint32 ina = in[kAIndex] * ca >> 8;
 
@@ -274,7 +461,11 @@ void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height,
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<SubtractiveBlendSSE2>(in, out, width, inStep, color);
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kRIndex] = MAX(out[kRIndex] - ((in[kRIndex] * out[kRIndex]) * in[kAIndex] >> 16), 0);
@@ -297,7 +488,11 @@ void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height,
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<SubtractiveBlendColorSSE2>(in, out, width, inStep, color);
+#endif
+			for (; j < width; j++) {
 
 				out[kAIndex] = 255;
 				if (cb != 255) {
@@ -338,7 +533,11 @@ void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<MultiplyBlendSSE2>(in, out, width, inStep, color);
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kRIndex] = MIN((in[kRIndex] * in[kAIndex] >> 8) * out[kRIndex] >> 8, 255);
@@ -361,7 +560,11 @@ void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<MultiplyBlendColorSSE2>(in, out, width, inStep, color);
+#endif
+			for (; j < width; j++) {
 
 				uint32 ina = in[kAIndex] * ca >> 8;
 
@@ -86,6 +86,11 @@
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
 
+#ifdef __SSE2__
+#define USE_SSE2_YUV_TO_RGB
+#include <emmintrin.h>
+#endif
+
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
 }
@@ -192,6 +197,112 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+#ifdef USE_SSE2_YUV_TO_RGB
+
+/**
+ * Converts eight pixels at a time with SSE2. The chroma offsets are still
+ * taken from the color tables, but the clamping, scaling and packing done
+ * by the rgb-to-pixel lookup is computed directly, which gives the same
+ * pixels as the lookup.
+ */
+class YUVToRGBConverterSSE2 {
+public:
+	YUVToRGBConverterSSE2(const YUVToRGBLookup *lookup, const int16 *colorTab) {
+		const Graphics::PixelFormat format = lookup->getFormat();
+
+		_crRTab = colorTab;
+		_crGTab = _crRTab + 256;
+		_cbGTab = _crGTab + 256;
+		_cbBTab = _cbGTab + 256;
+		_itu = (lookup->getScale() == YUVToRGBManager::kScaleITU);
+
+		_rLoss = _mm_cvtsi32_si128(format.rLoss);
+		_gLoss = _mm_cvtsi32_si128(format.gLoss);
+		_bLoss = _mm_cvtsi32_si128(format.bLoss);
+		_rShift = _mm_cvtsi32_si128(format.rShift);
+		_gShift = _mm_cvtsi32_si128(format.gShift);
+		_bShift = _mm_cvtsi32_si128(format.bShift);
+		_alpha16 = _mm_set1_epi16((int16)format.RGBToColor(0, 0, 0));
+		_alpha32 = _mm_set1_epi32(format.RGBToColor(0, 0, 0));
+	}
+
+	/** Convert eight pixels, with one chroma sample per pixel. */
+	template<typename PixelInt>
+	void convert444(byte *dstPtr, const byte *ySrc, const byte *uSrc, const byte *vSrc) const {
+		int16 r[8], g[8], b[8];
+		for (int i = 0; i < 8; i++)
+			getOffsets(uSrc[i], vSrc[i], r[i], g[i], b[i]);
+
+		convert<PixelInt>(dstPtr, ySrc, _mm_loadu_si128((const __m128i *)r), _mm_loadu_si128((const __m128i *)g), _mm_loadu_si128((const __m128i *)b));
+	}
+
+	/** Convert two rows of eight pixels, with one chroma sample per 2x2 pixels. */
+	template<typename PixelInt>
+	void convert420(byte *dstPtr, int dstPitch, const byte *ySrc, int yPitch, const byte *uSrc, const byte *vSrc) const {
+		int16 r[4], g[4], b[4];
+		for (int i = 0; i < 4; i++)
+			getOffsets(uSrc[i], vSrc[i], r[i], g[i], b[i]);
+
+		__m128i rOffsets = _mm_loadl_epi64((const __m128i *)r);
+		__m128i gOffsets = _mm_loadl_epi64((const __m128i *)g);
+		__m128i bOffsets = _mm_loadl_epi64((const __m128i *)b);
+		rOffsets = _mm_unpacklo_epi16(rOffsets, rOffsets);
+		gOffsets = _mm_unpacklo_epi16(gOffsets, gOffsets);
+		bOffsets = _mm_unpacklo_epi16(bOffsets, bOffsets);
+
+		convert<PixelInt>(dstPtr, ySrc, rOffsets, gOffsets, bOffsets);
+		convert<PixelInt>(dstPtr + dstPitch, ySrc + yPitch, rOffsets, gOffsets, bOffsets);
+	}
+
+private:
+	void getOffsets(byte u, byte v, int16 &r, int16 &g, int16 &b) const {
+		// Remove the offsets into the rgb-to-pixel lookup
+		r = _crRTab[v] - (0 * 768 + 256);
+		g = _crGTab[v] + _cbGTab[u] - (1 * 768 + 256);
+		b = _cbBTab[u] - (2 * 768 + 256);
+	}
+
+	__m128i clampChannel(__m128i value) const {
+		if (!_itu)
+			return _mm_min_epi16(_mm_max_epi16(value, _mm_setzero_si128()), _mm_set1_epi16(255));
+
+		// Scale [16, 235] to [0, 255]. n * 12 * 898 >> 16 equals n * 36 / 219
+		// for all n in [0, 219], so this matches (n * 255 / 219) exactly.
+		const __m128i n = _mm_sub_epi16(_mm_min_epi16(_mm_max_epi16(value, _mm_set1_epi16(16)), _mm_set1_epi16(235)), _mm_set1_epi16(16));
+		return _mm_add_epi16(n, _mm_mulhi_epu16(_mm_mullo_epi16(n, _mm_set1_epi16(12)), _mm_set1_epi16(898)));
+	}
+
+	template<typename PixelInt>
+	void convert(byte *dstPtr, const byte *ySrc, __m128i rOffsets, __m128i gOffsets, __m128i bOffsets) const {
+		const __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)ySrc), _mm_setzero_si128());
+		const __m128i r = _mm_srl_epi16(clampChannel(_mm_add_epi16(y, rOffsets)), _rLoss);
+		const __m128i g = _mm_srl_epi16(clampChannel(_mm_add_epi16(y, gOffsets)), _gLoss);
+		const __m128i b = _mm_srl_epi16(clampChannel(_mm_add_epi16(y, bOffsets)), _bLoss);
+
+		if (sizeof(PixelInt) == 2) {
+			__m128i pixels = _mm_or_si128(_mm_sll_epi16(r, _rShift), _mm_sll_epi16(g, _gShift));
+			pixels = _mm_or_si128(pixels, _mm_sll_epi16(b, _bShift));
+			_mm_storeu_si128((__m128i *)dstPtr, _mm_or_si128(pixels, _alpha16));
+		} else {
+			const __m128i zero = _mm_setzero_si128();
+			__m128i lo = _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(r, zero), _rShift), _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), _gShift));
+			__m128i hi = _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(r, zero), _rShift), _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), _gShift));
+			lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(b, zero), _bShift));
+			hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(b, zero), _bShift));
+			_mm_storeu_si128((__m128i *)dstPtr, _mm_or_si128(lo, _alpha32));
+			_mm_storeu_si128((__m128i *)(dstPtr + 16), _mm_or_si128(hi, _alpha32));
+		}
+	}
+
+	const int16 *_crRTab, *_crGTab, *_cbGTab, *_cbBTab;
+	bool _itu;
+	__m128i _rLoss, _gLoss, _bLoss;
+	__m128i _rShift, _gShift, _bShift;
+	__m128i _alpha16, _alpha32;
+};
+
+#endif
+
 #define PUT_PIXEL(s, d) \
 	L = &rgbToPix[(s)]; \
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b])
@@ -205,8 +316,24 @@ void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const int16 *Cb_b_tab = Cb_g_tab + 256;
 	const uint32 *rgbToPix = lookup->getRGBToPix();
 
+#ifdef USE_SSE2_YUV_TO_RGB
+	const YUVToRGBConverterSSE2 converter(lookup, colorTab);
+#endif
+
 	for (int h = 0; h < yHeight; h++) {
-		for (int w = 0; w < yWidth; w++) {
+		int w = 0;
+
+#ifdef USE_SSE2_YUV_TO_RGB
+		for (; w + 8 <= yWidth; w += 8) {
+			converter.convert444<PixelInt>(dstPtr, ySrc, uSrc, vSrc);
+			ySrc += 8;
+			uSrc += 8;
+			vSrc += 8;
+			dstPtr += 8 * sizeof(PixelInt);
+		}
+#endif
+
+		for (; w < yWidth; w++) {
 			register const uint32 *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -254,8 +381,24 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const int16 *Cb_b_tab = Cb_g_tab + 256;
 	const uint32 *rgbToPix = lookup->getRGBToPix();
 
+#ifdef USE_SSE2_YUV_TO_RGB
+	const YUVToRGBConverterSSE2 converter(lookup, colorTab);
+#endif
+
 	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
+		int w = 0;
+
+#ifdef USE_SSE2_YUV_TO_RGB
+		for (; w + 4 <= halfWidth; w += 4) {
+			converter.convert420<PixelInt>(dstPtr, dstPitch, ySrc, yPitch, uSrc, vSrc);
+			ySrc += 8;
+			uSrc += 4;
+			vSrc += 4;
+			dstPtr += 8 * sizeof(PixelInt);
+		}
+#endif
+
+		for (; w < halfWidth; w++) {
 			register const uint32 *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -274,7 +417,7 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 			dstPtr += sizeof(PixelInt);
 		}
 
-		dstPtr += dstPitch;
+		dstPtr += (dstPitch << 1) - yWidth * sizeof(PixelInt);
 		ySrc += (yPitch << 1) - yWidth;
 		uSrc += uvPitch - halfWidth;
 		vSrc += uvPitch - halfWidth;
@@ -527,7 +527,7 @@ bool ThemeEngine::init() {
 			// Look for the zip file via SearchMan
 			Common::ArchiveMemberPtr member = SearchMan.getMember(_themeFile);
 			if (member) {
-				_themeArchive = Common::makeZipArchive(member->createReadStream());
+				_themeArchive = Common::makeZipArchive(member);
 				if (!_themeArchive) {
 					warning("Failed to open Zip archive '%s'.", member->getDisplayName().c_str());
 				}
@@ -2241,12 +2241,10 @@ bool ThemeEngine::themeConfigUsable(const Common::FSNode &node, Common::String &
 			// Open THEMERC from the ZIP file.
 			stream.open("THEMERC", *zipArchive);
 		}
-		// Delete the ZIP archive again. Note: This only works because
-		// stream.open() only uses ZipArchive::createReadStreamForMember,
-		// and that in turn happens to read all the data for a given
-		// archive member into a memory block. So there will be no dangling
-		// reference to zipArchive anywhere. This could change if we
-		// ever modify ZipArchive::createReadStreamForMember.
+		// Delete the ZIP archive again. Note: This works because streams
+		// created by ZipArchive::createReadStreamForMember do not refer
+		// to the ZipArchive object, so there will be no dangling
+		// reference to zipArchive anywhere.
 		delete zipArchive;
 	} else if (node.isDirectory()) {
 		Common::FSNode headerfile = node.getChild("THEMERC");
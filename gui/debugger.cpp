@@ -25,7 +25,9 @@
 
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/memorypool.h"
 #include "common/system.h"
+#include "common/timer.h"
 
 #ifndef DISABLE_MD5
 #include "common/md5.h"
@@ -78,6 +80,10 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+
+	registerCmd("timers",			WRAP_METHOD(Debugger, cmdTimers));
+	registerCmd("mempool",			WRAP_METHOD(Debugger, cmdMemoryPool));
+	registerCmd("searchman",		WRAP_METHOD(Debugger, cmdSearchMan));
 }
 
 Debugger::~Debugger() {
@@ -745,4 +751,43 @@ bool Debugger::debuggerCompletionCallback(GUI::ConsoleDialog *console, const cha
 
 #endif
 
+bool Debugger::cmdTimers(int argc, const char **argv) {
+	const Common::TimerManager::TimerStatsList stats = g_system->getTimerManager()->getTimerStats();
+
+	if (stats.empty()) {
+		debugPrintf("No timer statistics available\n");
+		return true;
+	}
+
+	debugPrintf("Interval(us)  Calls     Avg late(ms)  Max late(ms)  Overruns  Id\n");
+	for (Common::TimerManager::TimerStatsList::const_iterator i = stats.begin(); i != stats.end(); ++i) {
+		debugPrintf("%-12d  %-8u  %-12u  %-12u  %-8u  %s\n", i->interval, i->calls,
+				i->calls ? i->totalLateness / i->calls : 0, i->maxLateness, i->overruns, i->id.c_str());
+	}
+	return true;
+}
+
+bool Debugger::cmdMemoryPool(int argc, const char **argv) {
+	const Common::Array<Common::SharedMemoryPool::SizeClassStats> stats = SharedMemPool.getStats();
+
+	debugPrintf("Size  Allocations  In use    Pooled\n");
+	for (uint i = 0; i < stats.size(); ++i) {
+		if (!stats[i].allocations)
+			continue;
+
+		if (stats[i].chunkSize)
+			debugPrintf("%-4u  %-11u  %-8u  %u\n", (uint)stats[i].chunkSize, stats[i].allocations, stats[i].inUse, (uint)stats[i].numChunks);
+		else
+			debugPrintf("%-4s  %-11u  %-8u  -\n", "more", stats[i].allocations, stats[i].inUse);
+	}
+	return true;
+}
+
+bool Debugger::cmdSearchMan(int argc, const char **argv) {
+	uint32 hits, misses;
+	SearchMan.getLookupCacheStats(hits, misses);
+	debugPrintf("File lookups: %u from cache, %u searched in archives\n", hits, misses);
+	return true;
+}
+
 } // End of namespace GUI
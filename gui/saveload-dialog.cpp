@@ -176,6 +176,9 @@ void SaveLoadChooserDialog::close() {
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 	CloudMan.setSyncTarget(nullptr); //not that dialog, at least
 #endif
+	// The saves might change until the dialog is shown again.
+	_metaInfoCache.clear();
+	_metaInfoLRU.clear();
 	Dialog::close();
 }
 
@@ -289,6 +292,8 @@ void SaveLoadChooserDialog::updateSaveList() {
 
 void SaveLoadChooserDialog::listSaves() {
 	if (!_metaEngine) return; //very strange
+	_metaInfoCache.clear();
+	_metaInfoLRU.clear();
 	_saveList = _metaEngine->listSaves(_target.c_str());
 
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
@@ -319,6 +324,27 @@ void SaveLoadChooserDialog::listSaves() {
 #endif
 }
 
+SaveStateDescriptor SaveLoadChooserDialog::getSaveMetaInfos(int slot) {
+	MetaInfoCache::const_iterator i = _metaInfoCache.find(slot);
+	if (i != _metaInfoCache.end()) {
+		_metaInfoLRU.remove(slot);
+		_metaInfoLRU.push_back(slot);
+		return i->_value;
+	}
+
+	SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), slot);
+
+	// Limit the number of thumbnails we keep around.
+	if (_metaInfoCache.size() >= kMetaInfoCacheSize) {
+		_metaInfoCache.erase(_metaInfoLRU.front());
+		_metaInfoLRU.pop_front();
+	}
+
+	_metaInfoCache[slot] = desc;
+	_metaInfoLRU.push_back(slot);
+	return desc;
+}
+
 #ifndef DISABLE_SAVELOADCHOOSER_GRID
 void SaveLoadChooserDialog::addChooserButtons() {
 	if (_listButton) {
@@ -532,7 +558,7 @@ void SaveLoadChooserSimple::updateSelection(bool redraw) {
 	_playtime->setLabel(_("No playtime saved"));
 
 	if (selItem >= 0 && _metaInfoSupport) {
-		SaveStateDescriptor desc = (_saveList[selItem].getLocked() ? _saveList[selItem] : _metaEngine->querySaveMetaInfos(_target.c_str(), _saveList[selItem].getSaveSlot()));
+		SaveStateDescriptor desc = (_saveList[selItem].getLocked() ? _saveList[selItem] : getSaveMetaInfos(_saveList[selItem].getSaveSlot()));
 
 		isDeletable = desc.getDeletableFlag() && _delSupport;
 		isWriteProtected = desc.getWriteProtectedFlag();
@@ -710,7 +736,7 @@ enum {
 
 SaveLoadChooserGrid::SaveLoadChooserGrid(const Common::String &title, bool saveMode)
 	: SaveLoadChooserDialog("SaveLoadChooser", saveMode), _lines(0), _columns(0), _entriesPerPage(0),
-	_curPage(0), _newSaveContainer(0), _nextFreeSaveSlot(0), _buttons() {
+	_curPage(0), _nextLazyEntry(0), _newSaveContainer(0), _nextFreeSaveSlot(0), _buttons() {
 	_backgroundType = ThemeEngine::kDialogBackgroundSpecial;
 
 	new StaticTextWidget(this, "SaveLoadChooser.Title", title);
@@ -833,7 +859,7 @@ void SaveLoadChooserGrid::open() {
 			// In case there was a gap found use the slot.
 			if (lastSlot + 1 < curSlot) {
 				// Check that the save slot can be used for user saves.
-				SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), lastSlot + 1);
+				SaveStateDescriptor desc = getSaveMetaInfos(lastSlot + 1);
 				if (!desc.getWriteProtectedFlag()) {
 					_nextFreeSaveSlot = lastSlot + 1;
 					break;
@@ -847,7 +873,7 @@ void SaveLoadChooserGrid::open() {
 		const int maxSlot = _metaEngine->getMaximumSaveSlot();
 		for (int i = lastSlot; _nextFreeSaveSlot == -1 && i < maxSlot; ++i) {
 			// Check that the save slot can be used for user saves.
-			SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), i + 1);
+			SaveStateDescriptor desc = getSaveMetaInfos(i + 1);
 			if (!desc.getWriteProtectedFlag()) {
 				_nextFreeSaveSlot = i + 1;
 			}
@@ -1040,58 +1066,25 @@ void SaveLoadChooserGrid::updateSaves() {
 
 	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
 		const uint saveSlot = _saveList[i].getSaveSlot();
-
-		SaveStateDescriptor desc =  (_saveList[i].getLocked() ? _saveList[i] : _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot));
 		SlotButton &curButton = _buttons[curNum];
 		curButton.setVisible(true);
-		const Graphics::Surface *thumbnail = desc.getThumbnail();
-		if (thumbnail) {
-			curButton.button->setGfx(desc.getThumbnail());
-		} else {
-			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
-		}
-		curButton.description->setLabel(Common::String::format("%d. %s", saveSlot, desc.getDescription().c_str()));
-
-		Common::String tooltip(_("Name: "));
-		tooltip += desc.getDescription();
 
-		if (_saveDateSupport) {
-			const Common::String &saveDate = desc.getSaveDate();
-			if (!saveDate.empty()) {
-				tooltip += "\n";
-				tooltip +=  _("Date: ") + saveDate;
-			}
-
-			const Common::String &saveTime = desc.getSaveTime();
-			if (!saveTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Time: ") + saveTime;
-			}
-		}
-
-		if (_playTimeSupport) {
-			const Common::String &playTime = desc.getPlayTime();
-			if (!playTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Playtime: ") + playTime;
-			}
-		}
-
-		curButton.button->setTooltip(tooltip);
-
-		// In save mode we disable the button, when it's write protected.
-		// TODO: Maybe we should not display it at all then?
-		if (_saveMode && desc.getWriteProtectedFlag()) {
-			curButton.button->setEnabled(false);
+		// Saves whose meta infos are not loaded yet only show their
+		// description for now. The rest is filled in by handleTickle.
+		// Until then the button is disabled, since it is not known yet
+		// whether the save is write protected.
+		if (_saveList[i].getLocked()) {
+			updateSlotButton(curButton, _saveList[i]);
+		} else if (hasCachedSaveMetaInfos(saveSlot)) {
+			updateSlotButton(curButton, getSaveMetaInfos(saveSlot));
 		} else {
-			curButton.button->setEnabled(true);
+			updateSlotButton(curButton, SaveStateDescriptor(saveSlot, _saveList[i].getDescription()));
+			curButton.button->setEnabled(false);
 		}
-
-		//that would make it look "disabled" if slot is locked
-		curButton.button->setEnabled(!desc.getLocked());
-		curButton.description->setEnabled(!desc.getLocked());
 	}
 
+	_nextLazyEntry = _curPage * _entriesPerPage;
+
 	const uint numPages = (_entriesPerPage != 0 && !_saveList.empty()) ? ((_saveList.size() + _entriesPerPage - 1) / _entriesPerPage) : 1;
 	_pageDisplay->setLabel(Common::String::format("%u/%u", _curPage + 1, numPages));
 
@@ -1106,6 +1099,76 @@ void SaveLoadChooserGrid::updateSaves() {
 		_nextButton->setEnabled(false);
 }
 
+void SaveLoadChooserGrid::updateSlotButton(SlotButton &button, const SaveStateDescriptor &desc) {
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail) {
+		button.button->setGfx(desc.getThumbnail());
+	} else {
+		button.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	}
+	button.description->setLabel(Common::String::format("%d. %s", desc.getSaveSlot(), desc.getDescription().c_str()));
+
+	Common::String tooltip(_("Name: "));
+	tooltip += desc.getDescription();
+
+	if (_saveDateSupport) {
+		const Common::String &saveDate = desc.getSaveDate();
+		if (!saveDate.empty()) {
+			tooltip += "\n";
+			tooltip +=  _("Date: ") + saveDate;
+		}
+
+		const Common::String &saveTime = desc.getSaveTime();
+		if (!saveTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Time: ") + saveTime;
+		}
+	}
+
+	if (_playTimeSupport) {
+		const Common::String &playTime = desc.getPlayTime();
+		if (!playTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Playtime: ") + playTime;
+		}
+	}
+
+	button.button->setTooltip(tooltip);
+
+	// In save mode we disable the button, when it's write protected.
+	// TODO: Maybe we should not display it at all then?
+	if (_saveMode && desc.getWriteProtectedFlag()) {
+		button.button->setEnabled(false);
+	} else {
+		button.button->setEnabled(true);
+	}
+
+	//that would make it look "disabled" if slot is locked
+	button.button->setEnabled(!desc.getLocked());
+	button.description->setEnabled(!desc.getLocked());
+}
+
+void SaveLoadChooserGrid::handleTickle() {
+	// Load the meta infos of one save of the current page per tickle. This
+	// keeps the dialog responsive while the thumbnails are being decoded.
+	const uint firstEntry = _curPage * _entriesPerPage;
+	const uint pageEnd = MIN<uint>(MIN<uint>(firstEntry + _entriesPerPage, firstEntry + _buttons.size()), _saveList.size());
+	_nextLazyEntry = MAX(_nextLazyEntry, firstEntry);
+	while (_nextLazyEntry < pageEnd) {
+		const SaveStateDescriptor &entry = _saveList[_nextLazyEntry];
+		SlotButton &curButton = _buttons[_nextLazyEntry - firstEntry];
+		++_nextLazyEntry;
+
+		if (!entry.getLocked() && !hasCachedSaveMetaInfos(entry.getSaveSlot())) {
+			updateSlotButton(curButton, getSaveMetaInfos(entry.getSaveSlot()));
+			draw();
+			break;
+		}
+	}
+
+	SaveLoadChooserDialog::handleTickle();
+}
+
 SavenameDialog::SavenameDialog()
 	: Dialog("SavenameDialog") {
 	_title = new StaticTextWidget(this, "SavenameDialog.DescriptionText", Common::String());
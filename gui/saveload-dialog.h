@@ -26,6 +26,8 @@
 #include "gui/dialog.h"
 #include "gui/widgets/list.h"
 
+#include "common/list.h"
+
 #include "engines/metaengine.h"
 
 namespace GUI {
@@ -110,6 +112,17 @@ protected:
 	*/
 	virtual void listSaves();
 
+	/**
+	 * Query the meta infos of a save slot from the MetaEngine.
+	 *
+	 * The result is cached until the save list is refreshed, so that
+	 * redrawing the chooser does not read every save file again.
+	 */
+	SaveStateDescriptor getSaveMetaInfos(int slot);
+
+	/** Check whether the meta infos of a save slot are cached. */
+	bool hasCachedSaveMetaInfos(int slot) const { return _metaInfoCache.contains(slot); }
+
 	const bool				_saveMode;
 	const MetaEngine		*_metaEngine;
 	bool					_delSupport;
@@ -121,6 +134,14 @@ protected:
 	bool _dialogWasShown;
 	SaveStateList			_saveList;
 
+	typedef Common::HashMap<int, SaveStateDescriptor> MetaInfoCache;
+	MetaInfoCache			_metaInfoCache;
+	/** Cached slots, least recently used first. */
+	Common::List<int>		_metaInfoLRU;
+	enum {
+		kMetaInfoCacheSize = 64
+	};
+
 #ifndef DISABLE_SAVELOADCHOOSER_GRID
 	ButtonWidget *_listButton;
 	ButtonWidget *_gridButton;
@@ -206,6 +227,7 @@ public:
 protected:
 	virtual void handleCommand(CommandSender *sender, uint32 cmd, uint32 data);
 	virtual void handleMouseWheel(int x, int y, int direction);
+	virtual void handleTickle();
 	virtual void updateSaveList();
 private:
 	virtual int runIntern();
@@ -213,6 +235,8 @@ private:
 	uint _columns, _lines;
 	uint _entriesPerPage;
 	uint _curPage;
+	/** Next entry of the current page whose meta infos might not be loaded yet. */
+	uint _nextLazyEntry;
 
 	ButtonWidget *_nextButton;
 	ButtonWidget *_prevButton;
@@ -243,6 +267,7 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+	void updateSlotButton(SlotButton &button, const SaveStateDescriptor &desc);
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
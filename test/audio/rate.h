@@ -0,0 +1,434 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decoders/raw.h"
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+#include "common/config-manager.h"
+#include "common/system.h"
+#include "common/stream.h"
+#include "common/endian.h"
+#include "common/util.h"
+
+#include <math.h>
+
+class RateConverterTestSuite : public CxxTest::TestSuite
+{
+private:
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 8;
+	}
+
+	/** Create a stream of pseudo random noise, which also covers the extreme sample values. */
+	static Audio::AudioStream *createNoiseStream(const int sampleRate, const int samples, const bool isStereo) {
+		byte *data = (byte *)malloc(samples * 2);
+		uint32 seed = 42;
+
+		for (int i = 0; i < samples; ++i) {
+			int16 sample;
+			switch (i % 16) {
+			case 3:
+				sample = -32768;
+				break;
+			case 7:
+				sample = 32767;
+				break;
+			default:
+				sample = (int16)nextRandom(seed);
+			}
+			WRITE_LE_UINT16(data + i * 2, sample);
+		}
+
+		Common::SeekableReadStream *s = new Common::MemoryReadStream(data, samples * 2, DisposeAfterUse::YES);
+		return Audio::makeRawStream(s, sampleRate, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | (isStereo ? Audio::FLAG_STEREO : 0));
+	}
+
+	/**
+	 * Check that mixing with channel volumes into a non-empty buffer gives
+	 * the same result as the scalar formula applied to the unscaled output.
+	 */
+	void checkVolumeMixing(const int inRate, const int outRate, const bool isStereo, const bool reverseStereo) {
+		const int frames = 1001;
+		const int inSamples = 4096 * (isStereo ? 2 : 1);
+		const Audio::st_volume_t volL = 173, volR = 250;
+
+		// Output of the converter at full volume into an empty buffer.
+		int16 *reference = new int16[frames * 2];
+		memset(reference, 0, frames * 2 * sizeof(int16));
+		Audio::AudioStream *s = createNoiseStream(inRate, inSamples, isStereo);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, isStereo, reverseStereo);
+		const int refFrames = converter->flow(*s, reference, frames, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+		TS_ASSERT_EQUALS(refFrames, frames);
+		delete converter;
+		delete s;
+
+		// Output of the converter with volumes into a prefilled buffer.
+		int16 *mixed = new int16[frames * 2];
+		int16 *expected = new int16[frames * 2];
+		uint32 seed = 7;
+		for (int i = 0; i < frames * 2; ++i) {
+			mixed[i] = expected[i] = (int16)nextRandom(seed);
+
+			const Audio::st_volume_t vol = ((i & 1) == (reverseStereo ? 1 : 0)) ? volL : volR;
+			int val = expected[i] + (reference[i] * (int)vol) / Audio::Mixer::kMaxMixerVolume;
+			expected[i] = (int16)CLIP<int>(val, -32768, 32767);
+		}
+
+		s = createNoiseStream(inRate, inSamples, isStereo);
+		converter = Audio::makeRateConverter(inRate, outRate, isStereo, reverseStereo);
+		TS_ASSERT_EQUALS(converter->flow(*s, mixed, frames, volL, volR), frames);
+		delete converter;
+		delete s;
+
+		TS_ASSERT_EQUALS(memcmp(mixed, expected, frames * 2 * sizeof(int16)), 0);
+
+		delete[] reference;
+		delete[] mixed;
+		delete[] expected;
+	}
+
+	/**
+	 * Check that mixing into a 32-bit buffer adds the volume scaled samples
+	 * without clamping them.
+	 */
+	void checkVolumeMixing32(const int inRate, const int outRate, const bool isStereo) {
+		const int frames = 1001;
+		const int inSamples = 4096 * (isStereo ? 2 : 1);
+		const Audio::st_volume_t volL = 256, volR = 99;
+
+		int16 *reference = new int16[frames * 2];
+		memset(reference, 0, frames * 2 * sizeof(int16));
+		Audio::AudioStream *s = createNoiseStream(inRate, inSamples, isStereo);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, isStereo);
+		TS_ASSERT_EQUALS(converter->flow(*s, reference, frames, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), frames);
+		delete converter;
+		delete s;
+
+		int32 *mixed = new int32[frames * 2];
+		int32 *expected = new int32[frames * 2];
+		for (int i = 0; i < frames * 2; ++i) {
+			mixed[i] = (i % 3 - 1) * 40000;
+			expected[i] = mixed[i] + (reference[i] * (int)((i & 1) ? volR : volL)) / Audio::Mixer::kMaxMixerVolume;
+		}
+
+		s = createNoiseStream(inRate, inSamples, isStereo);
+		converter = Audio::makeRateConverter(inRate, outRate, isStereo);
+		TS_ASSERT_EQUALS(converter->flow32(*s, mixed, frames, volL, volR), frames);
+		delete converter;
+		delete s;
+
+		TS_ASSERT_EQUALS(memcmp(mixed, expected, frames * 2 * sizeof(int32)), 0);
+
+		delete[] reference;
+		delete[] mixed;
+		delete[] expected;
+	}
+
+	/**
+	 * Just enough of an OSystem for QueuingAudioStream, which needs mutexes.
+	 * The tests run on a single thread, so the mutexes do nothing.
+	 */
+	class MutexOnlyOSystem : public OSystem {
+	public:
+		const GraphicsMode *getSupportedGraphicsModes() const { return 0; }
+		int getDefaultGraphicsMode() const { return 0; }
+		bool setGraphicsMode(int mode) { return false; }
+		int getGraphicsMode() const { return 0; }
+		Graphics::PixelFormat getScreenFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+		Common::List<Graphics::PixelFormat> getSupportedFormats() const { return Common::List<Graphics::PixelFormat>(); }
+		void initSize(uint width, uint height, const Graphics::PixelFormat *format) {}
+		int16 getHeight() { return 0; }
+		int16 getWidth() { return 0; }
+		PaletteManager *getPaletteManager() { return 0; }
+		void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) {}
+		Graphics::Surface *lockScreen() { return 0; }
+		void unlockScreen() {}
+		void fillScreen(uint32 col) {}
+		void updateScreen() {}
+		void setShakePos(int shakeOffset) {}
+		void showOverlay() {}
+		void hideOverlay() {}
+		Graphics::PixelFormat getOverlayFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+		void clearOverlay() {}
+		void grabOverlay(void *buf, int pitch) {}
+		void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) {}
+		int16 getOverlayHeight() { return 0; }
+		int16 getOverlayWidth() { return 0; }
+		bool showMouse(bool visible) { return false; }
+		void warpMouse(int x, int y) {}
+		void setMouseCursor(const void *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, bool dontScale, const Graphics::PixelFormat *format) {}
+		uint32 getMillis(bool skipRecord) { return 0; }
+		void delayMillis(uint msecs) {}
+		void getTimeAndDate(TimeDate &t) const {}
+		MutexRef createMutex() { return (MutexRef)this; }
+		void lockMutex(MutexRef mutex) {}
+		void unlockMutex(MutexRef mutex) {}
+		void deleteMutex(MutexRef mutex) {}
+		Audio::Mixer *getMixer() { return 0; }
+		void quit() {}
+		void displayMessageOnOSD(const char *msg) {}
+		void displayActivityIconOnOSD(const Graphics::Surface *icon) {}
+		void logMessage(LogMessageType::Type type, const char *message) {}
+	};
+
+	/** Create a queuing stream and queue a constant signal of the given length. */
+	static void queueConstant(Audio::QueuingAudioStream &stream, const int samples, const int16 value) {
+		byte *data = (byte *)malloc(samples * 2);
+		for (int i = 0; i < samples; ++i)
+			WRITE_LE_UINT16(data + i * 2, value);
+		stream.queueBuffer(data, samples * 2, DisposeAfterUse::YES, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN);
+	}
+
+	/**
+	 * Convert a stream in small chunks like the mixer does, as long as the
+	 * mixer would call the converter. Returns the number of frames written.
+	 */
+	static int mixLikeMixer(Audio::AudioStream &stream, Audio::RateConverter &converter, int16 *out, const int maxFrames) {
+		int frames = 0;
+		while (frames < maxFrames && (!stream.endOfData() || (stream.endOfStream() && converter.hasPendingOutput()))) {
+			const int len = converter.flow(stream, out + frames * 2, MIN(256, maxFrames - frames), Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+			if (len == 0)
+				break;
+			frames += len;
+		}
+		return frames;
+	}
+
+	/** Enable or disable the FIR rate converter for the converters created afterwards. */
+	static void setFIRConverter(bool enable) {
+		if (enable)
+			ConfMan.set("resampler", "fir", Common::ConfigManager::kTransientDomain);
+		else
+			ConfMan.removeKey("resampler", Common::ConfigManager::kTransientDomain);
+	}
+
+	/** Convert a sine wave and return the peak amplitude of the result. */
+	static int convertSine(const int inRate, const int outRate, const int frequency, const int amplitude) {
+		const int inSamples = inRate / 4;
+		byte *data = (byte *)malloc(inSamples * 2);
+		for (int i = 0; i < inSamples; ++i)
+			WRITE_LE_UINT16(data + i * 2, (int16)(sin(2 * M_PI * frequency * i / inRate) * amplitude));
+
+		Common::SeekableReadStream *s = new Common::MemoryReadStream(data, inSamples * 2, DisposeAfterUse::YES);
+		Audio::AudioStream *stream = Audio::makeRawStream(s, inRate, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN);
+
+		const int frames = outRate / 8;
+		int16 *out = new int16[frames * 2];
+		memset(out, 0, frames * 2 * sizeof(int16));
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, false);
+		converter->flow(*stream, out, frames, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+
+		// Skip the filter latency at the start
+		int peak = 0;
+		for (int i = 2 * 64; i < frames * 2; ++i)
+			peak = MAX<int>(peak, ABS<int>(out[i]));
+
+		delete converter;
+		delete stream;
+		delete[] out;
+		return peak;
+	}
+
+public:
+	void test_copy_mono() {
+		checkVolumeMixing(22050, 22050, false, false);
+	}
+
+	void test_copy_stereo() {
+		checkVolumeMixing(22050, 22050, true, false);
+	}
+
+	void test_copy_stereo_reversed() {
+		checkVolumeMixing(22050, 22050, true, true);
+	}
+
+	void test_simple_mono() {
+		checkVolumeMixing(44100, 22050, false, false);
+	}
+
+	void test_simple_stereo_reversed() {
+		checkVolumeMixing(44100, 22050, true, true);
+	}
+
+	void test_linear_mono() {
+		checkVolumeMixing(11025, 48000, false, false);
+	}
+
+	void test_linear_stereo() {
+		checkVolumeMixing(22050, 48000, true, false);
+	}
+
+	void test_linear_stereo_reversed() {
+		checkVolumeMixing(22050, 44100, true, true);
+	}
+
+	void test_copy_32bit() {
+		checkVolumeMixing32(22050, 22050, true);
+	}
+
+	void test_simple_32bit() {
+		checkVolumeMixing32(44100, 22050, false);
+	}
+
+	void test_linear_32bit() {
+		checkVolumeMixing32(11025, 44100, true);
+	}
+
+	void test_fir_volume() {
+		setFIRConverter(true);
+		checkVolumeMixing(11025, 48000, false, false);
+		checkVolumeMixing(22050, 44100, true, true);
+		checkVolumeMixing(44100, 22050, true, false);
+		checkVolumeMixing32(32000, 11025, true);
+		setFIRConverter(false);
+	}
+
+	void test_fir_dc() {
+		// A constant signal must come out unchanged once the filter is filled.
+		const int inSamples = 2000;
+		byte *data = (byte *)malloc(inSamples * 2);
+		for (int i = 0; i < inSamples; ++i)
+			WRITE_LE_UINT16(data + i * 2, 10000);
+		Common::SeekableReadStream *s = new Common::MemoryReadStream(data, inSamples * 2, DisposeAfterUse::YES);
+		Audio::AudioStream *stream = Audio::makeRawStream(s, 11025, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN);
+
+		setFIRConverter(true);
+		Audio::RateConverter *converter = Audio::makeRateConverter(11025, 48000, false);
+		setFIRConverter(false);
+
+		int16 out[2 * 4000];
+		memset(out, 0, sizeof(out));
+		TS_ASSERT_EQUALS(converter->flow(*stream, out, 4000, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), 4000);
+		for (int i = 2 * 100; i < 2 * 4000; ++i)
+			TS_ASSERT_EQUALS(out[i], 10000);
+
+		delete converter;
+		delete stream;
+	}
+
+	void test_fir_flush() {
+		// The filter delays the signal, so the last input samples only come
+		// out once the converter has been flushed at the end of the stream.
+		const int inSamples = 2000;
+		byte *data = (byte *)malloc(inSamples * 2);
+		for (int i = 0; i < inSamples; ++i)
+			WRITE_LE_UINT16(data + i * 2, 10000);
+		Common::SeekableReadStream *s = new Common::MemoryReadStream(data, inSamples * 2, DisposeAfterUse::YES);
+		Audio::AudioStream *stream = Audio::makeRawStream(s, 11025, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN);
+
+		setFIRConverter(true);
+		Audio::RateConverter *converter = Audio::makeRateConverter(11025, 44100, false);
+		setFIRConverter(false);
+
+		// Read in small chunks, like the mixer does.
+		const int maxFrames = inSamples * 4 + 2000;
+		int16 *out = new int16[maxFrames * 2];
+		memset(out, 0, maxFrames * 2 * sizeof(int16));
+		int frames = 0;
+		while (frames < maxFrames && (!stream->endOfData() || converter->hasPendingOutput())) {
+			const int len = converter->flow(*stream, out + frames * 2, MIN(256, maxFrames - frames), Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+			if (len == 0)
+				break;
+			frames += len;
+		}
+		TS_ASSERT(!converter->hasPendingOutput());
+
+		// Every input sample produces four output samples above half the
+		// input level, including the ones at the end.
+		int loud = 0;
+		for (int i = 0; i < frames; ++i)
+			if (out[i * 2] > 5000)
+				++loud;
+		TS_ASSERT_LESS_THAN_EQUALS(inSamples * 4 - 4, loud);
+		TS_ASSERT_LESS_THAN_EQUALS(loud, inSamples * 4 + 4);
+		TS_ASSERT_LESS_THAN(out[(frames - 1) * 2], 100);
+
+		delete[] out;
+		delete converter;
+		delete stream;
+	}
+
+	void test_fir_underrun() {
+		// A queuing stream which runs out of data for a while must not be
+		// flushed, so it gives the same output as if it never ran dry.
+		const int inSamples = 1000;
+		const int maxFrames = inSamples * 2 * 4 + 2000;
+		int16 *reference = new int16[maxFrames * 2];
+		int16 *out = new int16[maxFrames * 2];
+		memset(reference, 0, maxFrames * 2 * sizeof(int16));
+		memset(out, 0, maxFrames * 2 * sizeof(int16));
+
+		MutexOnlyOSystem system;
+		OSystem *oldSystem = g_system;
+		g_system = &system;
+		setFIRConverter(true);
+
+		Audio::QueuingAudioStream *stream = Audio::makeQueuingAudioStream(11025, false);
+		Audio::RateConverter *converter = Audio::makeRateConverter(11025, 44100, false);
+		queueConstant(*stream, inSamples, 10000);
+		queueConstant(*stream, inSamples, -10000);
+		stream->finish();
+		const int referenceFrames = mixLikeMixer(*stream, *converter, reference, maxFrames);
+		delete converter;
+		delete stream;
+
+		stream = Audio::makeQueuingAudioStream(11025, false);
+		converter = Audio::makeRateConverter(11025, 44100, false);
+		queueConstant(*stream, inSamples, 10000);
+		int frames = mixLikeMixer(*stream, *converter, out, maxFrames);
+		TS_ASSERT(stream->endOfData());
+		TS_ASSERT(!stream->endOfStream());
+
+		// Convert what the converter still has buffered. Once that is used
+		// up, the underrun must not produce any output, but the converter
+		// keeps the pending output for later.
+		int len;
+		while ((len = converter->flow(*stream, out + frames * 2, 256, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume)) > 0)
+			frames += len;
+		TS_ASSERT_EQUALS(converter->flow(*stream, out + frames * 2, 256, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), 0);
+		TS_ASSERT(converter->hasPendingOutput());
+
+		queueConstant(*stream, inSamples, -10000);
+		stream->finish();
+		frames += mixLikeMixer(*stream, *converter, out + frames * 2, maxFrames - frames);
+		delete converter;
+		delete stream;
+
+		setFIRConverter(false);
+		g_system = oldSystem;
+
+		TS_ASSERT_EQUALS(frames, referenceFrames);
+		TS_ASSERT_EQUALS(memcmp(out, reference, referenceFrames * 2 * sizeof(int16)), 0);
+
+		delete[] reference;
+		delete[] out;
+	}
+
+	void test_fir_frequency_response() {
+		setFIRConverter(true);
+		// Frequencies well below the output Nyquist frequency pass ...
+		const int passed = convertSine(44100, 11025, 1000, 16000);
+		TS_ASSERT(passed > 15600 && passed < 16400);
+		// ... while frequencies above it are removed instead of aliased.
+		const int stopped = convertSine(44100, 11025, 9000, 16000);
+		TS_ASSERT_LESS_THAN(stopped, 160);
+		setFIRConverter(false);
+
+		// For comparison: simple decimation aliases at full amplitude.
+		TS_ASSERT_LESS_THAN(15000, convertSine(44100, 11025, 9000, 16000));
+	}
+
+	void test_end_of_stream() {
+		// Asking for more output than the input provides must only mix the
+		// available frames.
+		int16 buffer[2 * 600];
+		memset(buffer, 0, sizeof(buffer));
+		Audio::AudioStream *s = createNoiseStream(22050, 500, false);
+		Audio::RateConverter *converter = Audio::makeRateConverter(22050, 22050, false);
+		TS_ASSERT_EQUALS(converter->flow(*s, buffer, 600, 128, 128), 500);
+		delete converter;
+		delete s;
+	}
+};
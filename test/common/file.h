@@ -0,0 +1,43 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/file.h"
+#include "common/memstream.h"
+
+class FileTestSuite : public CxxTest::TestSuite {
+	/** A stream which does not keep its content in memory. */
+	class ProxyReadStream : public Common::SeekableReadStream {
+		Common::SeekableReadStream &_stream;
+
+	public:
+		ProxyReadStream(Common::SeekableReadStream &stream) : _stream(stream) {}
+
+		bool eos() const { return _stream.eos(); }
+		uint32 read(void *dataPtr, uint32 dataSize) { return _stream.read(dataPtr, dataSize); }
+		int32 pos() const { return _stream.pos(); }
+		int32 size() const { return _stream.size(); }
+		bool seek(int32 offset, int whence = SEEK_SET) { return _stream.seek(offset, whence); }
+	};
+
+	public:
+	void test_direct_pointer() {
+		byte contents[] = { 1, 2, 3, 4, 5, 6, 7 };
+		Common::File file;
+		TS_ASSERT(file.open(new Common::MemoryReadStream(contents, sizeof(contents)), "contents"));
+
+		TS_ASSERT_EQUALS(file.getDirectPointer(), contents);
+		file.seek(5);
+		TS_ASSERT_EQUALS(file.getDirectPointer(), contents + 5);
+		TS_ASSERT_EQUALS(file.readByte(), 6);
+		TS_ASSERT_EQUALS(*file.getDirectPointer(), 7);
+	}
+
+	void test_direct_pointer_unsupported() {
+		// Streams which do not keep their content in memory return 0
+		byte contents[] = { 1, 2, 3, 4, 5, 6, 7 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		Common::File file;
+		TS_ASSERT(file.open(new ProxyReadStream(ms), "contents"));
+
+		TS_ASSERT(!file.getDirectPointer());
+	}
+};
@@ -0,0 +1,178 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/flathashmap.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		Common::FlatHashMap<Common::String, Common::String> container2;
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(!container2.empty());
+		container2.clear(true);
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		TS_ASSERT_EQUALS(container2["foo"], "bar");
+	}
+
+	void test_contains() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(container.contains(0));
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.contains(17));
+		TS_ASSERT(!container.contains(-1));
+
+		Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> container2;
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(container2.contains("foo"));
+		TS_ASSERT(container2.contains("QUUX"));
+		TS_ASSERT(!container2.contains("bar"));
+		TS_ASSERT(!container2.contains("asdf"));
+	}
+
+	void test_add_remove() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		TS_ASSERT(container.contains(1));
+		container.erase(1);
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT(container.contains(1));
+		container.erase(0);
+		TS_ASSERT(!container.empty());
+		container.erase(1);
+		TS_ASSERT(!container.empty());
+		container.erase(2);
+		TS_ASSERT(!container.empty());
+		container.erase(3);
+		TS_ASSERT(!container.empty());
+		container.erase(container.find(4));
+		TS_ASSERT(container.empty());
+		container[1] = 33;
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.empty());
+		container.erase(container.find(1));
+		TS_ASSERT(container.empty());
+	}
+
+	void test_lookup_with_default() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = -1;
+		container[2] = 45;
+
+		// We take a const ref now to ensure that the map
+		// is not modified by getVal.
+		const Common::FlatHashMap<int, int> &containerRef = container;
+
+		TS_ASSERT_EQUALS(containerRef.getVal(0), 17);
+		TS_ASSERT_EQUALS(containerRef.getVal(1), -1);
+		TS_ASSERT_EQUALS(containerRef.getVal(17), 0);
+		TS_ASSERT_EQUALS(containerRef.getVal(0, -10), 17);
+		TS_ASSERT_EQUALS(containerRef.getVal(17, -10), -10);
+		TS_ASSERT_EQUALS(container.size(), 3u);
+	}
+
+	void test_copy() {
+		Common::FlatHashMap<Common::String, int> map1, container2;
+		map1["x"] = 32;
+		map1["y"] = 5;
+		container2 = map1;
+		map1["x"] = 1;
+		TS_ASSERT_EQUALS(container2["x"], 32);
+		TS_ASSERT_EQUALS(container2["y"], 5);
+
+		Common::FlatHashMap<Common::String, int> container3(map1);
+		TS_ASSERT_EQUALS(container3["x"], 1);
+		TS_ASSERT_EQUALS(container3.size(), 2u);
+	}
+
+	void test_collision() {
+		// Keys which are multiples of a power of two must neither end up in
+		// the same slot, nor be lost when moved back by an erase.
+		Common::FlatHashMap<int, int> h;
+		for (int i = 0; i < 12; ++i)
+			h[i * 1024 + 5] = i;
+		for (int i = 0; i < 12; i += 2)
+			h.erase(i * 1024 + 5);
+		for (int i = 0; i < 12; ++i) {
+			TS_ASSERT_EQUALS(h.contains(i * 1024 + 5), (i & 1) != 0);
+			if (i & 1)
+				TS_ASSERT_EQUALS(h[i * 1024 + 5], i);
+		}
+		TS_ASSERT_EQUALS(h.size(), 6u);
+	}
+
+	void test_iterator() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		container.erase(1);
+		container[1] = 42;
+		container.erase(0);
+		container.erase(1);
+
+		int found = 0;
+		Common::FlatHashMap<int, int>::const_iterator i;
+		for (i = container.begin(); i != container.end(); ++i) {
+			int key = i->_key;
+			TS_ASSERT(key >= 0 && key <= 4);
+			TS_ASSERT(!(found & (1 << key)));
+			found |= 1 << key;
+		}
+		TS_ASSERT(found == 16+8+4);
+	}
+
+	void test_against_hashmap() {
+		// Run the same pseudo random sequence of operations on a HashMap
+		// and a FlatHashMap, and check that both end up with the same content.
+		Common::HashMap<uint, uint> reference;
+		Common::FlatHashMap<uint, uint> container;
+		uint32 seed = 12345;
+
+		for (int i = 0; i < 20000; ++i) {
+			seed = seed * 1103515245 + 12345;
+			const uint key = (seed >> 16) & 1023;
+			if (seed & 0x10000000) {
+				reference.erase(key);
+				container.erase(key);
+			} else {
+				reference[key] = i;
+				container[key] = i;
+			}
+			TS_ASSERT_EQUALS(reference.size(), container.size());
+		}
+
+		for (Common::HashMap<uint, uint>::const_iterator it = reference.begin(); it != reference.end(); ++it)
+			TS_ASSERT_EQUALS(container.getVal(it->_key, (uint)-1), it->_value);
+
+		uint count = 0;
+		for (Common::FlatHashMap<uint, uint>::const_iterator it = container.begin(); it != container.end(); ++it) {
+			TS_ASSERT(reference.contains(it->_key));
+			++count;
+		}
+		TS_ASSERT_EQUALS(count, reference.size());
+	}
+};
@@ -104,4 +104,16 @@ class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 		ms.seek(0, SEEK_SET);
 		TS_ASSERT(!ms.eos());
 	}
+
+	void test_direct_pointer() {
+		byte contents[] = { 1, 2, 3, 4, 5, 6, 7 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		TS_ASSERT_EQUALS(ms.getDirectPointer(), contents);
+		ms.readUint16LE();
+		TS_ASSERT_EQUALS(ms.getDirectPointer(), contents + 2);
+		TS_ASSERT_EQUALS(ms.pos(), 2);
+		ms.seek(-1, SEEK_END);
+		TS_ASSERT_EQUALS(*ms.getDirectPointer(), 7);
+	}
 };
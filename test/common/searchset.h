@@ -0,0 +1,96 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+
+class SearchSetTestSuite : public CxxTest::TestSuite
+{
+private:
+	/** An archive with a fixed set of empty members, which counts the queries. */
+	class CountingArchive : public Common::Archive {
+	public:
+		CountingArchive(const char *member) : _member(member), _queries(0) {}
+
+		virtual bool hasFile(const Common::String &name) const {
+			_queries++;
+			return name == _member;
+		}
+
+		virtual int listMembers(Common::ArchiveMemberList &list) const {
+			list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_member, this)));
+			return 1;
+		}
+
+		virtual const Common::ArchiveMemberPtr getMember(const Common::String &name) const {
+			return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(name, this));
+		}
+
+		virtual Common::SeekableReadStream *createReadStreamForMember(const Common::String &name) const {
+			_queries++;
+			if (name != _member)
+				return 0;
+			return new Common::MemoryReadStream((const byte *)_member.c_str(), _member.size());
+		}
+
+		Common::String _member;
+		mutable int _queries;
+	};
+
+public:
+	void test_lookup_cache() {
+		Common::SearchSet set;
+		CountingArchive *a = new CountingArchive("a.dat");
+		CountingArchive *b = new CountingArchive("b.dat");
+		set.add("a", a);
+		set.add("b", b);
+
+		TS_ASSERT(set.hasFile("b.dat"));
+		TS_ASSERT(!set.hasFile("c.dat"));
+		TS_ASSERT_EQUALS(a->_queries, 2);
+		TS_ASSERT_EQUALS(b->_queries, 2);
+
+		// Repeated lookups must not query the archives again
+		TS_ASSERT(set.hasFile("b.dat"));
+		TS_ASSERT(!set.hasFile("c.dat"));
+		TS_ASSERT_EQUALS(a->_queries, 2);
+		TS_ASSERT_EQUALS(b->_queries, 2);
+
+		uint32 hits, misses;
+		set.getLookupCacheStats(hits, misses);
+		TS_ASSERT_EQUALS(hits, 2u);
+		TS_ASSERT_EQUALS(misses, 2u);
+
+		// Opening a known member only asks the archive which has it
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("b.dat");
+		TS_ASSERT(stream);
+		delete stream;
+		TS_ASSERT_EQUALS(a->_queries, 2);
+		TS_ASSERT_EQUALS(b->_queries, 3);
+	}
+
+	void test_lookup_cache_invalidation() {
+		Common::SearchSet set;
+		set.add("low", new CountingArchive("x.dat"), 0);
+		TS_ASSERT(!set.hasFile("y.dat"));
+
+		// New archives must be visible, also when they take precedence
+		CountingArchive *high = new CountingArchive("x.dat");
+		set.add("y", new CountingArchive("y.dat"), 0);
+		set.add("high", high, 10);
+		TS_ASSERT(set.hasFile("y.dat"));
+
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("x.dat");
+		delete stream;
+		TS_ASSERT_EQUALS(high->_queries, 2);
+
+		set.remove("y");
+		TS_ASSERT(!set.hasFile("y.dat"));
+
+		// Changes to a nested search set are seen by its parent
+		Common::SearchSet *nested = new Common::SearchSet();
+		set.add("nested", nested);
+		TS_ASSERT(!set.hasFile("z.dat"));
+		nested->add("z", new CountingArchive("z.dat"));
+		TS_ASSERT(set.hasFile("z.dat"));
+	}
+};
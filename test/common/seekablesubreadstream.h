@@ -70,4 +70,19 @@ class SeekableSubReadStreamTestSuite : public CxxTest::TestSuite {
 		b = ssrs.readByte();
 		TS_ASSERT_EQUALS(b, 1);
 	}
+
+	void test_direct_pointer() {
+		byte contents[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Common::MemoryReadStream ms(contents, 10);
+		Common::SafeSeekableSubReadStream ssrs(&ms, 2, 8);
+
+		TS_ASSERT_EQUALS(ssrs.getDirectPointer(), contents + 2);
+		ssrs.seek(3);
+		TS_ASSERT_EQUALS(*ssrs.getDirectPointer(), 5);
+
+		// Moving the parent must not affect the substream
+		ms.seek(9);
+		TS_ASSERT_EQUALS(*ssrs.getDirectPointer(), 5);
+		TS_ASSERT_EQUALS(ssrs.readByte(), 5);
+	}
 };
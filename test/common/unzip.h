@@ -0,0 +1,258 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "common/unzip.h"
+#include "common/zlib.h"
+
+class UnzipTestSuite : public CxxTest::TestSuite
+{
+private:
+	struct Member {
+		const char *name;
+		uint32 size;
+		bool compress;
+		bool badCRC;
+	};
+
+	/**
+	 * ZIP archive in memory, which can be opened several times like a file.
+	 */
+	class MemoryMember : public Common::ArchiveMember {
+		const byte *_data;
+		uint32 _size;
+
+	public:
+		MemoryMember(const byte *data, uint32 size) : _data(data), _size(size) {}
+
+		Common::SeekableReadStream *createReadStream() const {
+			return new Common::MemoryReadStream(_data, _size);
+		}
+
+		Common::String getName() const {
+			return "test.zip";
+		}
+	};
+
+	static byte memberByte(uint32 memberIndex, uint32 pos) {
+		// Compressible, but not trivially repeating data
+		return (byte)((pos / 7) ^ (pos >> 11) ^ (memberIndex * 13));
+	}
+
+	static void writeUint16(Common::WriteStream &stream, uint16 value) { stream.writeUint16LE(value); }
+	static void writeUint32(Common::WriteStream &stream, uint32 value) { stream.writeUint32LE(value); }
+
+	/**
+	 * Create a ZIP archive in memory. The deflate data and the CRC are taken
+	 * from a gzip stream, which consists of a 10 byte header, the deflate
+	 * data and an 8 byte trailer containing the CRC and the size.
+	 */
+	static Common::MemoryWriteStreamDynamic *createZip(const Member *members, uint numMembers) {
+		Common::MemoryWriteStreamDynamic &zip = *new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+		Common::MemoryWriteStreamDynamic centralDir(DisposeAfterUse::YES);
+
+		for (uint i = 0; i < numMembers; ++i) {
+			byte *data = new byte[members[i].size];
+			for (uint32 j = 0; j < members[i].size; ++j)
+				data[j] = memberByte(i, j);
+
+			Common::MemoryWriteStreamDynamic *gzip = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+			Common::WriteStream *compressor = Common::wrapCompressedWriteStream(gzip);
+			compressor->write(data, members[i].size);
+			compressor->finalize();
+			const uint32 crc = READ_LE_UINT32(gzip->getData() + gzip->size() - 8) ^ (members[i].badCRC ? 1 : 0);
+			const byte *payload = members[i].compress ? gzip->getData() + 10 : data;
+			const uint32 payloadSize = members[i].compress ? gzip->size() - 18 : members[i].size;
+			const uint16 nameLength = strlen(members[i].name);
+			const uint32 localHeaderOffset = zip.size();
+
+			// Local file header
+			writeUint32(zip, 0x04034B50);
+			writeUint16(zip, 20);
+			writeUint16(zip, 0);
+			writeUint16(zip, members[i].compress ? 8 : 0);
+			writeUint32(zip, 0);
+			writeUint32(zip, crc);
+			writeUint32(zip, payloadSize);
+			writeUint32(zip, members[i].size);
+			writeUint16(zip, nameLength);
+			writeUint16(zip, 0);
+			zip.write(members[i].name, nameLength);
+			zip.write(payload, payloadSize);
+
+			// Central directory entry
+			writeUint32(centralDir, 0x02014B50);
+			writeUint16(centralDir, 20);
+			writeUint16(centralDir, 20);
+			writeUint16(centralDir, 0);
+			writeUint16(centralDir, members[i].compress ? 8 : 0);
+			writeUint32(centralDir, 0);
+			writeUint32(centralDir, crc);
+			writeUint32(centralDir, payloadSize);
+			writeUint32(centralDir, members[i].size);
+			writeUint16(centralDir, nameLength);
+			writeUint16(centralDir, 0);
+			writeUint16(centralDir, 0);
+			writeUint16(centralDir, 0);
+			writeUint16(centralDir, 0);
+			writeUint32(centralDir, 0);
+			writeUint32(centralDir, localHeaderOffset);
+			centralDir.write(members[i].name, nameLength);
+
+			delete compressor;
+			delete[] data;
+		}
+
+		const uint32 centralDirOffset = zip.size();
+		zip.write(centralDir.getData(), centralDir.size());
+
+		// End of central directory record
+		writeUint32(zip, 0x06054B50);
+		writeUint16(zip, 0);
+		writeUint16(zip, 0);
+		writeUint16(zip, numMembers);
+		writeUint16(zip, numMembers);
+		writeUint32(zip, centralDir.size());
+		writeUint32(zip, centralDirOffset);
+		writeUint16(zip, 0);
+
+		return &zip;
+	}
+
+	static Common::Archive *openZip(Common::MemoryWriteStreamDynamic &zip) {
+		return Common::makeZipArchive(Common::ArchiveMemberPtr(new MemoryMember(zip.getData(), zip.size())));
+	}
+
+	static bool checkContent(Common::SeekableReadStream &stream, uint32 memberIndex, uint32 pos, uint32 length) {
+		byte *buffer = new byte[length];
+		const bool sizeMatches = (stream.read(buffer, length) == length);
+		bool contentMatches = sizeMatches;
+		for (uint32 i = 0; i < length && contentMatches; ++i)
+			contentMatches = (buffer[i] == memberByte(memberIndex, pos + i));
+		delete[] buffer;
+		return contentMatches;
+	}
+
+public:
+	void test_members() {
+		const Member members[] = {
+			{ "small.txt", 1000, true, false },
+			{ "large.bin", 300000, true, false },
+			{ "stored.bin", 70000, false, false }
+		};
+		Common::MemoryWriteStreamDynamic *zip = createZip(members, ARRAYSIZE(members));
+		Common::Archive *archive = openZip(*zip);
+		TS_ASSERT(archive);
+		if (!archive) {
+			delete zip;
+			return;
+		}
+
+		for (uint i = 0; i < ARRAYSIZE(members); ++i) {
+			Common::SeekableReadStream *stream = archive->createReadStreamForMember(members[i].name);
+			TS_ASSERT(stream);
+			if (!stream)
+				continue;
+
+			TS_ASSERT_EQUALS(stream->size(), (int32)members[i].size);
+			TS_ASSERT(checkContent(*stream, i, 0, members[i].size));
+			TS_ASSERT(!stream->err());
+			delete stream;
+		}
+
+		delete archive;
+		delete zip;
+	}
+
+	void test_in_memory_archive() {
+		const Member members[] = {
+			{ "large.bin", 300000, true, false }
+		};
+		Common::MemoryWriteStreamDynamic *zip = createZip(members, ARRAYSIZE(members));
+		byte *data = (byte *)malloc(zip->size());
+		memcpy(data, zip->getData(), zip->size());
+		Common::Archive *archive = Common::makeZipArchive(new Common::MemoryReadStream(data, zip->size(), DisposeAfterUse::YES));
+		delete zip;
+		TS_ASSERT(archive);
+		if (!archive)
+			return;
+
+		Common::SeekableReadStream *stream = archive->createReadStreamForMember("large.bin");
+		delete archive;
+
+		TS_ASSERT(stream);
+		if (stream) {
+			TS_ASSERT_EQUALS(stream->size(), (int32)members[0].size);
+			TS_ASSERT(checkContent(*stream, 0, 0, members[0].size));
+		}
+		delete stream;
+	}
+
+	void test_crc_mismatch() {
+		const Member members[] = {
+			{ "deflated.bin", 100000, true, true },
+			{ "stored.bin", 100000, false, true }
+		};
+		Common::MemoryWriteStreamDynamic *zip = createZip(members, ARRAYSIZE(members));
+		Common::Archive *archive = openZip(*zip);
+		TS_ASSERT(archive);
+		if (!archive) {
+			delete zip;
+			return;
+		}
+
+		for (uint i = 0; i < ARRAYSIZE(members); ++i) {
+			Common::SeekableReadStream *stream = archive->createReadStreamForMember(members[i].name);
+			TS_ASSERT(stream);
+			if (!stream)
+				continue;
+
+			TS_ASSERT(checkContent(*stream, i, 0, members[i].size));
+			TS_ASSERT(stream->err());
+			delete stream;
+		}
+
+		delete archive;
+		delete zip;
+	}
+
+	void test_interleaved_seeking() {
+		const Member members[] = {
+			{ "a.bin", 200000, true, false },
+			{ "b.bin", 100000, false, false }
+		};
+		Common::MemoryWriteStreamDynamic *zip = createZip(members, ARRAYSIZE(members));
+		Common::Archive *archive = openZip(*zip);
+		TS_ASSERT(archive);
+		if (!archive) {
+			delete zip;
+			return;
+		}
+
+		Common::SeekableReadStream *a = archive->createReadStreamForMember("a.bin");
+		Common::SeekableReadStream *b = archive->createReadStreamForMember("b.bin");
+
+		// Streams must stay usable after the archive is gone.
+		delete archive;
+
+		TS_ASSERT(a && b);
+		if (a && b) {
+			TS_ASSERT(checkContent(*a, 0, 0, 5000));
+			TS_ASSERT(checkContent(*b, 1, 0, 5000));
+			a->seek(150000);
+			b->seek(90000);
+			TS_ASSERT(checkContent(*a, 0, 150000, 5000));
+			TS_ASSERT(checkContent(*b, 1, 90000, 5000));
+			a->seek(1000);
+			TS_ASSERT(checkContent(*a, 0, 1000, 5000));
+			TS_ASSERT(checkContent(*b, 1, 95000, 5000));
+			a->seek(-100, SEEK_END);
+			TS_ASSERT(checkContent(*a, 0, 200000 - 100, 100));
+		}
+
+		delete a;
+		delete b;
+		delete zip;
+	}
+};
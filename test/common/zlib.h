@@ -0,0 +1,87 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/zlib.h"
+
+class ZlibTestSuite : public CxxTest::TestSuite
+{
+private:
+	static byte dataByte(uint32 pos) {
+		// Compressible, but not trivially repeating data
+		return (byte)((pos / 5) ^ (pos >> 9) ^ (pos >> 17) * 3);
+	}
+
+	static Common::SeekableReadStream *createCompressedStream(uint32 size, uint32 accessPointMemory = Common::kDefaultAccessPointMemory) {
+		Common::MemoryWriteStreamDynamic *compressed = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *compressor = Common::wrapCompressedWriteStream(compressed);
+		for (uint32 i = 0; i < size; ++i)
+			compressor->writeByte(dataByte(i));
+		compressor->finalize();
+
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream(compressed->getData(), compressed->size(), DisposeAfterUse::YES);
+		delete compressor;
+		return Common::wrapCompressedReadStream(stream, 0, accessPointMemory);
+	}
+
+	static bool checkContent(Common::SeekableReadStream &stream, uint32 length) {
+		const uint32 start = stream.pos();
+		for (uint32 i = 0; i < length; ++i) {
+			if (stream.readByte() != dataByte(start + i))
+				return false;
+		}
+		return true;
+	}
+
+public:
+	void test_read() {
+		const uint32 size = 3 * 1024 * 1024;
+		Common::SeekableReadStream *stream = createCompressedStream(size);
+		TS_ASSERT_EQUALS(stream->size(), (int32)size);
+		TS_ASSERT(checkContent(*stream, size));
+		TS_ASSERT(!stream->err());
+		stream->readByte();
+		TS_ASSERT(stream->eos());
+		delete stream;
+	}
+
+	void test_seek() {
+		checkSeek(Common::kDefaultAccessPointMemory);
+	}
+
+	void test_seek_small_budget() {
+		// Room for only a few access points, so they have to be thinned
+		// out repeatedly while reading
+		checkSeek(4 * 32768);
+		checkSeek(32768);
+	}
+
+	void test_seek_no_access_points() {
+		checkSeek(0);
+	}
+
+private:
+	void checkSeek(uint32 accessPointMemory) {
+		const uint32 size = 3 * 1024 * 1024;
+		Common::SeekableReadStream *stream = createCompressedStream(size, accessPointMemory);
+
+		// Seek around, both backwards and forwards, before and after the
+		// data has been read once.
+		const int32 positions[] = { 2000000, 10, 1500000, 300000, 2900000, 0, 1048576, 2500000, 700000 };
+		for (uint i = 0; i < ARRAYSIZE(positions); ++i) {
+			TS_ASSERT(stream->seek(positions[i]));
+			TS_ASSERT_EQUALS(stream->pos(), positions[i]);
+			TS_ASSERT(checkContent(*stream, 1000));
+		}
+
+		TS_ASSERT(stream->seek(-100, SEEK_END));
+		TS_ASSERT(checkContent(*stream, 100));
+		stream->readByte();
+		TS_ASSERT(stream->eos());
+
+		TS_ASSERT(stream->seek(123456));
+		TS_ASSERT(!stream->eos());
+		TS_ASSERT(checkContent(*stream, 1000));
+		TS_ASSERT(!stream->err());
+		delete stream;
+	}
+};
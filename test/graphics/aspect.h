@@ -0,0 +1,78 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/colormasks.h"
+#include "graphics/scaler/aspect.h"
+#include "graphics/scaler/intern.h"
+
+extern int gBitFormat;
+
+class AspectTestSuite : public CxxTest::TestSuite
+{
+private:
+	/** Scalar version of the five to six line filter of Normal1xAspect. */
+	template<typename ColorMask>
+	static void referenceAspect(const uint16 *src, int srcPitch, uint16 *dst, int dstPitch, int width, int height) {
+		for (int y = 0; y < height * 6 / 5; ++y) {
+			const uint16 *line = src + (y - y / 6) * srcPitch;
+			const uint16 *prev = line - srcPitch;
+			uint16 *out = dst + y * dstPitch;
+			for (int x = 0; x < width; ++x) {
+				switch (y % 6) {
+				case 0:
+					out[x] = line[x];
+					break;
+				case 1:
+					out[x] = interpolate16_7_1<ColorMask>(line[x], prev[x]);
+					break;
+				case 2:
+					out[x] = interpolate16_5_3<ColorMask>(line[x], prev[x]);
+					break;
+				case 3:
+					out[x] = interpolate16_5_3<ColorMask>(prev[x], line[x]);
+					break;
+				case 4:
+					out[x] = interpolate16_7_1<ColorMask>(prev[x], line[x]);
+					break;
+				case 5:
+					out[x] = prev[x];
+					break;
+				}
+			}
+		}
+	}
+
+	template<typename ColorMask>
+	void checkAspect(int bitFormat) {
+		// An odd width covers both the vectorized and the scalar code
+		const int width = 37, height = 20;
+		uint16 src[width * height];
+		uint16 dst[width * height * 6 / 5];
+		uint16 expected[width * height * 6 / 5];
+
+		uint32 seed = 1;
+		for (int i = 0; i < width * height; ++i) {
+			seed = seed * 1103515245 + 12345;
+			src[i] = (uint16)(seed >> 16) & (ColorMask::kRedMask | ColorMask::kGreenMask | ColorMask::kBlueMask);
+		}
+		// Include the extreme channel values
+		src[3] = ColorMask::kRedMask | ColorMask::kGreenMask | ColorMask::kBlueMask;
+		src[3 + width] = 0;
+
+		const int oldBitFormat = gBitFormat;
+		gBitFormat = bitFormat;
+		Normal1xAspect((const uint8 *)src, width * 2, (uint8 *)dst, width * 2, width, height);
+		gBitFormat = oldBitFormat;
+
+		referenceAspect<ColorMask>(src, width, expected, width, width, height);
+		TS_ASSERT_EQUALS(memcmp(dst, expected, sizeof(dst)), 0);
+	}
+
+public:
+	void test_aspect_565() {
+		checkAspect<Graphics::ColorMasks<565> >(565);
+	}
+
+	void test_aspect_555() {
+		checkAspect<Graphics::ColorMasks<555> >(555);
+	}
+};
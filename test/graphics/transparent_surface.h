@@ -0,0 +1,101 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/rect.h"
+#include "graphics/transparent_surface.h"
+
+class TransparentSurfaceTestSuite : public CxxTest::TestSuite
+{
+private:
+	static void fillRandom(Graphics::Surface &surface, uint32 seed) {
+		byte *pixels = (byte *)surface.getPixels();
+		for (int i = 0; i < surface.pitch * surface.h; ++i) {
+			seed = seed * 1103515245 + 12345;
+			pixels[i] = (byte)(seed >> 16);
+		}
+
+		// Include fully transparent and fully opaque pixels
+		for (int y = 0; y < surface.h; ++y) {
+			*(uint32 *)surface.getBasePtr(y % surface.w, y) = 0;
+			*(uint32 *)surface.getBasePtr((y * 7 + 3) % surface.w, y) = 0xFFFFFFFF;
+		}
+	}
+
+	static bool equalPixels(const Graphics::Surface &a, const Graphics::Surface &b) {
+		return !memcmp(a.getPixels(), b.getPixels(), a.pitch * a.h);
+	}
+
+	/**
+	 * Check that blitting a sprite at once gives the same result as blitting
+	 * it column by column, which covers the scalar blending code only.
+	 */
+	void checkBlend(Graphics::TSpriteBlendMode blendMode, uint color) {
+		// An odd width covers both the vectorized and the scalar code
+		const int width = 37, height = 5;
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+
+		Graphics::TransparentSurface sprite;
+		sprite.create(width, height, format);
+		fillRandom(sprite, 1);
+
+		Graphics::Surface target;
+		target.create(width, height, format);
+		fillRandom(target, 2);
+
+		Graphics::Surface blitted;
+		blitted.copyFrom(target);
+		sprite.blit(blitted, 0, 0, Graphics::FLIP_NONE, nullptr, color, -1, -1, blendMode);
+
+		Graphics::Surface expected;
+		expected.copyFrom(target);
+		for (int x = 0; x < width; ++x) {
+			Common::Rect column(x, 0, x + 1, height);
+			sprite.blit(expected, x, 0, Graphics::FLIP_NONE, &column, color, -1, -1, blendMode);
+		}
+		TS_ASSERT(equalPixels(blitted, expected));
+
+		// Horizontally flipped blitting must match blitting a mirrored copy
+		Graphics::TransparentSurface mirrored;
+		mirrored.create(width, height, format);
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x)
+				*(uint32 *)mirrored.getBasePtr(x, y) = *(const uint32 *)sprite.getBasePtr(width - 1 - x, y);
+		}
+
+		blitted.copyFrom(target);
+		sprite.blit(blitted, 0, 0, Graphics::FLIP_H, nullptr, color, -1, -1, blendMode);
+		expected.copyFrom(target);
+		mirrored.blit(expected, 0, 0, Graphics::FLIP_NONE, nullptr, color, -1, -1, blendMode);
+		TS_ASSERT(equalPixels(blitted, expected));
+
+		sprite.free();
+		mirrored.free();
+		target.free();
+		blitted.free();
+		expected.free();
+	}
+
+	void checkBlendColors(Graphics::TSpriteBlendMode blendMode) {
+		checkBlend(blendMode, TS_ARGB(255, 255, 255, 255));
+		checkBlend(blendMode, TS_ARGB(255, 255, 128, 64));
+		checkBlend(blendMode, TS_ARGB(100, 30, 255, 200));
+		// Large products, which overflow in the subtractive blending
+		checkBlend(blendMode, TS_ARGB(254, 254, 254, 254));
+	}
+
+public:
+	void test_blend_normal() {
+		checkBlendColors(Graphics::BLEND_NORMAL);
+	}
+
+	void test_blend_additive() {
+		checkBlendColors(Graphics::BLEND_ADDITIVE);
+	}
+
+	void test_blend_subtractive() {
+		checkBlendColors(Graphics::BLEND_SUBTRACTIVE);
+	}
+
+	void test_blend_multiply() {
+		checkBlendColors(Graphics::BLEND_MULTIPLY);
+	}
+};
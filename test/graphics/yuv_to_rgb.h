@@ -0,0 +1,88 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/rect.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite
+{
+private:
+	static void fillRandom(byte *data, int size, uint32 seed) {
+		for (int i = 0; i < size; ++i) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = (byte)(seed >> 16);
+		}
+
+		// Include the extreme values
+		data[0] = 0;
+		data[size - 1] = 255;
+	}
+
+	/**
+	 * Check that converting a whole image gives the same pixels as converting
+	 * it in narrow strips, which only uses the lookup tables.
+	 */
+	void checkConversion(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, bool is420) {
+		// The widths cover both the vectorized and the scalar code
+		enum {
+			width = 38,
+			height = 6,
+			yPitch = width + 3,
+			maxUVPitch = width + 5
+		};
+		const int uvPitch = (is420 ? width / 2 : width) + 5;
+		const int stripWidth = is420 ? 2 : 1;
+
+		byte ySrc[yPitch * height], uSrc[maxUVPitch * height], vSrc[maxUVPitch * height];
+		fillRandom(ySrc, yPitch * height, 1);
+		fillRandom(uSrc, uvPitch * height, 2);
+		fillRandom(vSrc, uvPitch * height, 3);
+
+		Graphics::Surface converted, expected;
+		converted.create(width, height, format);
+		expected.create(width, height, format);
+
+		if (is420)
+			YUVToRGBMan.convert420(&converted, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+		else
+			YUVToRGBMan.convert444(&converted, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+
+		for (int x = 0; x < width; x += stripWidth) {
+			Graphics::Surface strip = expected.getSubArea(Common::Rect(x, 0, x + stripWidth, height));
+			const int uvOffset = x / stripWidth;
+			if (is420)
+				YUVToRGBMan.convert420(&strip, scale, ySrc + x, uSrc + uvOffset, vSrc + uvOffset, stripWidth, height, yPitch, uvPitch);
+			else
+				YUVToRGBMan.convert444(&strip, scale, ySrc + x, uSrc + uvOffset, vSrc + uvOffset, stripWidth, height, yPitch, uvPitch);
+		}
+
+		TS_ASSERT_EQUALS(memcmp(converted.getPixels(), expected.getPixels(), expected.pitch * height), 0);
+
+		converted.free();
+		expected.free();
+	}
+
+	void checkFormats(Graphics::YUVToRGBManager::LuminanceScale scale, bool is420) {
+		checkConversion(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), scale, is420);
+		checkConversion(Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0), scale, is420);
+		checkConversion(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), scale, is420);
+		checkConversion(Graphics::PixelFormat(4, 8, 8, 8, 0, 0, 8, 16, 0), scale, is420);
+	}
+
+public:
+	void test_convert420_full() {
+		checkFormats(Graphics::YUVToRGBManager::kScaleFull, true);
+	}
+
+	void test_convert420_itu() {
+		checkFormats(Graphics::YUVToRGBManager::kScaleITU, true);
+	}
+
+	void test_convert444_full() {
+		checkFormats(Graphics::YUVToRGBManager::kScaleFull, false);
+	}
+
+	void test_convert444_itu() {
+		checkFormats(Graphics::YUVToRGBManager::kScaleITU, false);
+	}
+};
@@ -46,6 +46,11 @@
 #include "video/binkdata.h"
 #include "video/bink_decoder.h"
 
+#ifdef __SSE2__
+#define USE_SSE2_IDCT
+#include <emmintrin.h>
+#endif
+
 static const uint32 kBIKfID = MKTAG('B', 'I', 'K', 'f');
 static const uint32 kBIKgID = MKTAG('B', 'I', 'K', 'g');
 static const uint32 kBIKhID = MKTAG('B', 'I', 'K', 'h');
@@ -1318,7 +1323,128 @@ static inline void IDCTCol(int16 *dest, const int16 *src) {
 	}
 }
 
+#ifdef USE_SSE2_IDCT
+
+/**
+ * The SSE2 IDCT transforms four columns or rows at a time in 32 bit lanes,
+ * and truncates the intermediate and final values to 16 bits exactly like
+ * the scalar code does by storing them in int16 arrays.
+ */
+
+/** Multiply the 32 bit lanes, keeping the lower 32 bits of the products. */
+static inline __m128i mulLo32SSE2(__m128i a, __m128i b) {
+	const __m128i even = _mm_mul_epu32(a, b);
+	const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+static inline __m128i mulShiftSSE2(__m128i x, int factor) {
+	return _mm_srai_epi32(mulLo32SSE2(x, _mm_set1_epi32(factor)), 11);
+}
+
+static inline __m128i packTruncateSSE2(__m128i lo, __m128i hi) {
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+	return _mm_packs_epi32(lo, hi);
+}
+
+static void transpose8x8SSE2(__m128i *rows) {
+	__m128i a[8], b[8];
+
+	for (int i = 0; i < 4; i++) {
+		a[i * 2 + 0] = _mm_unpacklo_epi16(rows[i * 2], rows[i * 2 + 1]);
+		a[i * 2 + 1] = _mm_unpackhi_epi16(rows[i * 2], rows[i * 2 + 1]);
+	}
+
+	for (int i = 0; i < 2; i++) {
+		b[i * 4 + 0] = _mm_unpacklo_epi32(a[i * 4 + 0], a[i * 4 + 2]);
+		b[i * 4 + 1] = _mm_unpackhi_epi32(a[i * 4 + 0], a[i * 4 + 2]);
+		b[i * 4 + 2] = _mm_unpacklo_epi32(a[i * 4 + 1], a[i * 4 + 3]);
+		b[i * 4 + 3] = _mm_unpackhi_epi32(a[i * 4 + 1], a[i * 4 + 3]);
+	}
+
+	for (int i = 0; i < 4; i++) {
+		rows[i * 2 + 0] = _mm_unpacklo_epi64(b[i], b[i + 4]);
+		rows[i * 2 + 1] = _mm_unpackhi_epi64(b[i], b[i + 4]);
+	}
+}
+
+/** The SSE2 version of IDCT_TRANSFORM, without munging. */
+static void idctTransformSSE2(__m128i *d, const __m128i *s) {
+	const __m128i a0 = _mm_add_epi32(s[0], s[4]);
+	const __m128i a1 = _mm_sub_epi32(s[0], s[4]);
+	const __m128i a2 = _mm_add_epi32(s[2], s[6]);
+	const __m128i a3 = mulShiftSSE2(_mm_sub_epi32(s[2], s[6]), A1);
+	const __m128i a4 = _mm_add_epi32(s[5], s[3]);
+	const __m128i a5 = _mm_sub_epi32(s[5], s[3]);
+	const __m128i a6 = _mm_add_epi32(s[1], s[7]);
+	const __m128i a7 = _mm_sub_epi32(s[1], s[7]);
+	const __m128i b0 = _mm_add_epi32(a4, a6);
+	const __m128i b1 = mulShiftSSE2(_mm_add_epi32(a5, a7), A3);
+	const __m128i b2 = _mm_add_epi32(_mm_sub_epi32(mulShiftSSE2(a5, A4), b0), b1);
+	const __m128i b3 = _mm_sub_epi32(mulShiftSSE2(_mm_sub_epi32(a6, a4), A1), b2);
+	const __m128i b4 = _mm_sub_epi32(_mm_add_epi32(mulShiftSSE2(a7, A2), b3), b1);
+	const __m128i a0a2 = _mm_add_epi32(a0, a2);
+	const __m128i a0s2 = _mm_sub_epi32(a0, a2);
+	const __m128i a1a3s2 = _mm_sub_epi32(_mm_add_epi32(a1, a3), a2);
+	const __m128i a1s3a2 = _mm_add_epi32(_mm_sub_epi32(a1, a3), a2);
+
+	d[0] = _mm_add_epi32(a0a2, b0);
+	d[1] = _mm_add_epi32(a1a3s2, b2);
+	d[2] = _mm_add_epi32(a1s3a2, b3);
+	d[3] = _mm_sub_epi32(a0s2, b4);
+	d[4] = _mm_add_epi32(a0s2, b4);
+	d[5] = _mm_sub_epi32(a1s3a2, b3);
+	d[6] = _mm_sub_epi32(a1a3s2, b2);
+	d[7] = _mm_sub_epi32(a0a2, b0);
+}
+
+/**
+ * Transform the eight 16 bit vectors in both halves, with one lane per
+ * column, and transpose the truncated results.
+ */
+static void idctPassSSE2(__m128i *rows, bool munge) {
+	__m128i lo[8], hi[8], outLo[8], outHi[8];
+
+	for (int i = 0; i < 8; i++) {
+		lo[i] = _mm_srai_epi32(_mm_unpacklo_epi16(rows[i], rows[i]), 16);
+		hi[i] = _mm_srai_epi32(_mm_unpackhi_epi16(rows[i], rows[i]), 16);
+	}
+
+	idctTransformSSE2(outLo, lo);
+	idctTransformSSE2(outHi, hi);
+
+	for (int i = 0; i < 8; i++) {
+		if (munge) {
+			outLo[i] = _mm_srai_epi32(_mm_add_epi32(outLo[i], _mm_set1_epi32(0x7F)), 8);
+			outHi[i] = _mm_srai_epi32(_mm_add_epi32(outHi[i], _mm_set1_epi32(0x7F)), 8);
+		}
+
+		rows[i] = packTruncateSSE2(outLo[i], outHi[i]);
+	}
+
+	transpose8x8SSE2(rows);
+}
+
+/** Compute the IDCT of a block into eight rows of 16 bit values. */
+static void idctSSE2(__m128i *rows, const int16 *block) {
+	for (int i = 0; i < 8; i++)
+		rows[i] = _mm_loadu_si128((const __m128i *)(block + 8 * i));
+
+	// The columns, followed by the rows of the transposed intermediate block
+	idctPassSSE2(rows, false);
+	idctPassSSE2(rows, true);
+}
+
+#endif
+
 void BinkDecoder::BinkVideoTrack::IDCT(int16 *block) {
+#ifdef USE_SSE2_IDCT
+	__m128i rows[8];
+	idctSSE2(rows, block);
+	for (int i = 0; i < 8; i++)
+		_mm_storeu_si128((__m128i *)(block + 8 * i), rows[i]);
+#else
 	int i;
 	int16 temp[64];
 
@@ -1327,26 +1453,49 @@ void BinkDecoder::BinkVideoTrack::IDCT(int16 *block) {
 	for (i = 0; i < 8; i++) {
 		IDCT_ROW( (&block[8*i]), (&temp[8*i]) );
 	}
+#endif
 }
 
 void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int16 *block) {
-	int i, j;
+	int i;
 
 	IDCT(block);
 	byte *dest = ctx.dest;
+#ifdef USE_SSE2_IDCT
+	// The sums wrap around like the byte additions of the scalar code
+	const __m128i mask = _mm_set1_epi16(0xFF);
+	for (i = 0; i < 8; i++, dest += ctx.pitch, block += 8) {
+		__m128i sum = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)dest), _mm_setzero_si128());
+		sum = _mm_and_si128(_mm_add_epi16(sum, _mm_loadu_si128((const __m128i *)block)), mask);
+		_mm_storel_epi64((__m128i *)dest, _mm_packus_epi16(sum, sum));
+	}
+#else
 	for (i = 0; i < 8; i++, dest += ctx.pitch, block += 8)
-		for (j = 0; j < 8; j++)
+		for (int j = 0; j < 8; j++)
 			 dest[j] += block[j];
+#endif
 }
 
 void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int16 *block) {
 	int i;
+#ifdef USE_SSE2_IDCT
+	__m128i rows[8];
+	idctSSE2(rows, block);
+
+	// Only the lower byte is stored, like in the scalar code
+	const __m128i mask = _mm_set1_epi16(0xFF);
+	for (i = 0; i < 8; i++) {
+		const __m128i row = _mm_and_si128(rows[i], mask);
+		_mm_storel_epi64((__m128i *)(ctx.dest + i * ctx.pitch), _mm_packus_epi16(row, row));
+	}
+#else
 	int16 temp[64];
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
 	for (i = 0; i < 8; i++) {
 		IDCT_ROW( (&ctx.dest[i*ctx.pitch]), (&temp[8*i]) );
 	}
+#endif
 }
 
 BinkDecoder::BinkAudioTrack::BinkAudioTrack(BinkDecoder::AudioInfo &audio, Audio::Mixer::SoundType soundType) :